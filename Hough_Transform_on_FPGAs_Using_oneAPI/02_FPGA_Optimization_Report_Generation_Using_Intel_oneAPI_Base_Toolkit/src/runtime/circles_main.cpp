@@ -0,0 +1,125 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <vector>
+#include <CL/sycl.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include "hough_circles.hpp"
+#include "image_loader.hpp"
+
+using namespace std;
+
+// Usage: hough_transform_circles [-g] [image.bmp|image.pgm r_min r_max [k]]
+// With no image the first 180x120 pixels of Assets/pic.bmp are used like the line
+// samples, radii 5..20, and the circles are checked against util/circle_golden_check_file.txt
+// (-g rewrites that file from the host reference). Every run is also checked against
+// the host reference: scatter votes per radius, 3x3 local maxima, k strongest by votes / samples.
+
+static vector<HoughCircle> reference_circles(const CircleSize &size, const char pixels[], uint k, uint threshold) {
+  vector<HoughCircle> all;
+  vector<short> votes(size.slice_size());
+  vector<int> dx, dy;
+  int width = size.width, height = size.height;
+  for (uint r = size.r_min; r <= size.r_max; r++) {
+    CircleReference(size, pixels, r, votes.data());
+    CircleOffsets(r, dx, dy);
+    uint samples = dx.size();
+    vector<HoughCircle> slice;
+    for (int b = 0; b < height; b++) {
+      for (int a = 0; a < width; a++) {
+        int v = votes[(size_t)b*width+a];
+        if (v < (int)max(threshold, 1u)) continue;
+        bool peak = true;
+        for (int db = -1; db <= 1 && peak; db++) {
+          for (int da = -1; da <= 1 && peak; da++) {
+            int y = b + db, x = a + da;
+            if ((db == 0 && da == 0) || x < 0 || y < 0 || x >= width || y >= height) continue;
+            bool earlier = db < 0 || (db == 0 && da < 0);
+            peak = earlier ? v > votes[(size_t)y*width+x] : v >= votes[(size_t)y*width+x];
+          }
+        }
+        if (peak) slice.push_back({a, b, r, (uint)v, samples});
+      }
+    }
+    // Strongest first, lower index first on equal votes
+    stable_sort(slice.begin(), slice.end(), [](const HoughCircle &x, const HoughCircle &y) { return x.votes > y.votes; });
+    if (slice.size() > k) slice.resize(k);
+    all.insert(all.end(), slice.begin(), slice.end());
+  }
+  // Radii compete on the covered fraction of their circumference
+  stable_sort(all.begin(), all.end(), StrongerCircle);
+  if (all.size() > k) all.resize(k);
+  return all;
+}
+
+static bool same_circles(const vector<HoughCircle> &x, const vector<HoughCircle> &y, uint tolerance) {
+  if (x.size() != y.size()) return false;
+  for (size_t i = 0; i < x.size(); i++) {
+    if (x[i].a != y[i].a || x[i].b != y[i].b || x[i].r != y[i].r) return false;
+    if (x[i].votes > y[i].votes + tolerance || y[i].votes > x[i].votes + tolerance) return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  bool write_golden = argc > 1 && strcmp(argv[1], "-g") == 0;
+  if (write_golden) {
+    argc--;
+    argv++;
+  }
+  bool golden_mode = argc < 4;
+  const char *path = golden_mode ? "Assets/pic.bmp" : argv[1];
+  CircleSize size;
+  size.r_min = golden_mode ? 5 : atoi(argv[2]);
+  size.r_max = golden_mode ? 20 : atoi(argv[3]);
+  uint k = (argc > 4) ? atoi(argv[4]) : 8;
+  uint threshold = 10;
+
+  vector<char> pixels;
+  try {
+    MappedImage image(path);
+    size.width = golden_mode ? 180 : image.width();
+    size.height = golden_mode ? 120 : image.height();
+    pixels.resize(size.slice_size());
+    if (golden_mode) image.BinarizeRaw(pixels.data(), pixels.size());
+    else image.Binarize(pixels.data());
+  } catch (std::exception const &e) {
+    cout << "Could not read " << path << ": " << e.what() << std::endl;
+    return 1;
+  }
+  cout << "Image: " << size.width << "x" << size.height << ", radii: " << size.r_min << ".." << size.r_max << std::endl;
+
+  vector<HoughCircle> expected = reference_circles(size, pixels.data(), k, threshold);
+  if (write_golden) {
+    ofstream golden("util/circle_golden_check_file.txt", ofstream::out);
+    for (auto &c : expected) golden << c.a << " " << c.b << " " << c.r << " " << c.votes << "\n";
+    cout << "Wrote util/circle_golden_check_file.txt" << std::endl;
+    return 0;
+  }
+
+  vector<HoughCircle> circles = FindHoughCircles(size, pixels.data(), k, threshold);
+  for (auto &c : circles) {
+    cout << "Circle: a " << c.a << ", b " << c.b << ", r " << c.r << ", votes " << c.votes << "/" << c.samples << std::endl;
+  }
+
+  bool failed = !same_circles(circles, expected, 0);
+  if (golden_mode) {
+    //Test the results against the golden results, votes within +-1 like the line samples
+    ifstream myFile("util/circle_golden_check_file.txt", ifstream::in);
+    vector<HoughCircle> golden;
+    HoughCircle c;
+    while (myFile >> c.a >> c.b >> c.r >> c.votes) golden.push_back(c);
+    failed = failed || !same_circles(circles, golden, 1);
+  }
+
+  if (failed) {printf("FAILED\n");}
+  else {printf("VERIFICATION PASSED!!\n");}
+
+  return failed;
+}
@@ -0,0 +1,189 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "hough_circles.hpp"
+
+class Circle_single_task_kernel;
+class Circle_ndrange_kernel;
+
+// Slice index to (a, b) at a fixed radius
+struct CircleDecoder {
+  uint width;
+  uint r;
+  uint samples;
+
+  HoughCircle operator()(uint64_t key) const {
+    uint votes = PeakVotes(key);
+    size_t index = PeakIndex(key);
+    HoughCircle circle;
+    circle.a = votes ? index % width : 0;
+    circle.b = votes ? index / width : 0;
+    circle.r = r;
+    circle.votes = votes;
+    circle.samples = samples;
+    return circle;
+  }
+};
+
+void CircleOffsets(uint r, std::vector<int> &dx, std::vector<int> &dy)
+{
+    dx.clear();
+    dy.clear();
+    // Eight samples per unit of radius visit every pixel of the rasterized circle
+    uint steps = std::max(8u, 8 * r);
+    for (uint s = 0; s < steps; s++) {
+      double angle = 2 * M_PI * s / steps;
+      int x = (int)std::lround(r * std::cos(angle));
+      int y = (int)std::lround(r * std::sin(angle));
+      bool seen = false;
+      for (size_t i = 0; i < dx.size() && !seen; i++) seen = dx[i] == x && dy[i] == y;
+      if (!seen) {
+        dx.push_back(x);
+        dy.push_back(y);
+      }
+    }
+}
+
+void CircleReference(const CircleSize &size, const char pixels[], uint r, short votes[])
+{
+    std::vector<int> dx, dy;
+    CircleOffsets(r, dx, dy);
+    std::fill(votes, votes + size.slice_size(), 0);
+    for (uint y = 0; y < size.height; y++) {
+      for (uint x = 0; x < size.width; x++) {
+        if (!pixels[(size_t)y*size.width+x]) continue;
+        for (size_t i = 0; i < dx.size(); i++) {
+          int a = (int)x - dx[i], b = (int)y - dy[i];
+          if (a >= 0 && b >= 0 && a < (int)size.width && b < (int)size.height) votes[(size_t)b*size.width+a]++;
+        }
+      }
+    }
+}
+
+event SubmitCircleVoting(queue &device_queue, HoughKernel kernel, const CircleSize &size, uint r,
+                         buffer<char, 1> &pixels_buf, buffer<int, 1> &offsets_buf, uint samples,
+                         buffer<short, 1> &slice_buf)
+{
+    int width = size.width;
+    int height = size.height;
+
+    if (ResolveHoughKernel(device_queue, kernel) == HoughKernel::single_task) {
+      return device_queue.submit([&](sycl::handler &cgh) {
+        auto _pixels = pixels_buf.get_access<sycl::access::mode::read>(cgh);
+        auto _offsets = offsets_buf.get_access<sycl::access::mode::read>(cgh);
+        auto _slice = slice_buf.get_access<sycl::access::mode::discard_write>(cgh);
+
+        cgh.single_task<class Circle_single_task_kernel>([=]() [[intel::kernel_args_restrict]] {
+          // Offsets in banked local memory, the unrolled sample loop reads CIRCLE_UNROLL of them per cycle
+          [[intel::numbanks(CIRCLE_UNROLL)]]
+          int dx_local[MAX_CIRCLE_SAMPLES];
+          [[intel::numbanks(CIRCLE_UNROLL)]]
+          int dy_local[MAX_CIRCLE_SAMPLES];
+          for (uint i = 0; i < samples; i++) {
+            dx_local[i] = _offsets[2*i];
+            dy_local[i] = _offsets[2*i+1];
+          }
+
+          for (int b = 0; b < height; b++) {
+            for (int a = 0; a < width; a++) {
+              short votes = 0;
+              for (uint i0 = 0; i0 < samples; i0 += CIRCLE_UNROLL) {
+                #pragma unroll
+                for (uint j = 0; j < CIRCLE_UNROLL; j++) {
+                  uint i = i0 + j;
+                  int x = a + dx_local[i];
+                  int y = b + dy_local[i];
+                  if (i < samples && x >= 0 && y >= 0 && x < width && y < height) {
+                    votes += _pixels[(size_t)y*width+x];
+                  }
+                }
+              }
+              _slice[(size_t)b*width+a] = votes;
+            }
+          }
+        });
+      });
+    }
+
+    return device_queue.submit([&](sycl::handler &cgh) {
+      auto _pixels = pixels_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _offsets = offsets_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _slice = slice_buf.get_access<sycl::access::mode::discard_write>(cgh);
+
+      cgh.parallel_for<class Circle_ndrange_kernel>(range<2>{(size_t)height, (size_t)width}, [=](id<2> idx) {
+        int b = idx[0], a = idx[1];
+        short votes = 0;
+        for (uint i = 0; i < samples; i++) {
+          int x = a + _offsets[2*i];
+          int y = b + _offsets[2*i+1];
+          if (x >= 0 && y >= 0 && x < width && y < height) votes += _pixels[(size_t)y*width+x];
+        }
+        _slice[(size_t)b*width+a] = votes;
+      });
+    });
+}
+
+std::vector<HoughCircle> FindHoughCircles(const CircleSize &size, const char pixels[], uint k, uint threshold,
+                                          HoughKernel kernel)
+{
+    if (size.r_min > size.r_max) {
+      throw std::invalid_argument("r_min must not exceed r_max");
+    }
+
+    // Offsets of every radius, interleaved (dx, dy), at offsets_index[r - r_min]
+    std::vector<int> offsets, dx, dy;
+    std::vector<uint> offsets_index, offsets_count;
+    for (uint r = size.r_min; r <= size.r_max; r++) {
+      CircleOffsets(r, dx, dy);
+      if (dx.size() > MAX_CIRCLE_SAMPLES) {
+        throw std::invalid_argument("radius exceeds MAX_CIRCLE_SAMPLES");
+      }
+      offsets_index.push_back(offsets.size() / 2);
+      offsets_count.push_back(dx.size());
+      for (size_t i = 0; i < dx.size(); i++) {
+        offsets.push_back(dx[i]);
+        offsets.push_back(dy[i]);
+      }
+    }
+
+    std::vector<HoughCircle> circles((size_t)size.radii() * k);
+    {
+      buffer<char, 1> pixels_buf(pixels, range<1>{size.slice_size()});
+      // One slice is reused by every radius, memory does not grow with the radius range
+      buffer<short, 1> slice_buf{range<1>{size.slice_size()}};
+      buffer<uint64_t, 1> candidates_buf{range<1>{PEAK_CHUNKS*MAX_PEAKS}};
+      buffer<HoughCircle, 1> circles_buf(circles.data(), range<1>{circles.size()});
+
+      queue device_queue = MakeHoughQueue();
+      kernel = ResolveHoughKernel(device_queue, kernel);
+      std::cout << "Voting kernel: " << (kernel == HoughKernel::single_task ? "single_task" : "nd_range") << std::endl;
+
+      std::vector<buffer<int, 1>> offsets_bufs;
+      event first, last;
+      for (uint i = 0; i < size.radii(); i++) {
+        uint r = size.r_min + i;
+        offsets_bufs.emplace_back(&offsets[2*offsets_index[i]], range<1>{2*offsets_count[i]});
+        event vote = SubmitCircleVoting(device_queue, kernel, size, r, pixels_buf, offsets_bufs.back(),
+                                        offsets_count[i], slice_buf);
+        SubmitPeakCandidates(device_queue, size.height, size.width, slice_buf, k, threshold, candidates_buf);
+        last = SubmitPeakMerge(device_queue, k, candidates_buf, CircleDecoder{size.width, r, offsets_count[i]}, circles_buf, (size_t)i*k);
+        if (i == 0) first = vote;
+      }
+
+      double time_kernel = (last.get_profiling_info<sycl::info::event_profiling::command_end>() -
+                            first.get_profiling_info<sycl::info::event_profiling::command_start>()) / NS;
+      std::cout << "Circle detection time: " << time_kernel << " seconds for " << size.radii() << " radii" << std::endl;
+    }
+
+    // Strongest k over all radii, relative to the circumference of each radius
+    std::stable_sort(circles.begin(), circles.end(), StrongerCircle);
+    circles.resize(std::min<size_t>(k, circles.size()));
+    while (!circles.empty() && circles.back().votes == 0) circles.pop_back();
+    return circles;
+}
@@ -0,0 +1,62 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#pragma once
+
+#include "hough_peaks.hpp"
+
+#define MAX_CIRCLE_SAMPLES 1024 // Most distinct pixels on one circle, covers radii up to 162
+#define CIRCLE_UNROLL 16 // Circle samples read per iteration of the single_task kernel
+
+// One detected circle: centre (a, b) and radius r.
+// A circle of radius r can collect at most samples (about 2*pi*r) votes
+struct HoughCircle {
+  int a;
+  int b;
+  uint r;
+  uint votes;
+  uint samples;
+};
+
+// Circles of different radii are ranked by the covered fraction votes / samples of their
+// circumference, raw votes would always favour the largest radius. Equal fractions keep
+// their order, so a stable sort still prefers the smaller radius and the lower index
+inline bool StrongerCircle(const HoughCircle &x, const HoughCircle &y)
+{
+    return (uint64_t)x.votes * y.samples > (uint64_t)y.votes * x.samples;
+}
+
+// Circle Hough transform over radii [r_min, r_max]. The 3D (a, b, r) accumulator is never
+// stored: one width x height slice is voted per radius and reduced to its k strongest
+// centres on the device before the next radius reuses the slice.
+struct CircleSize {
+  uint width;
+  uint height;
+  uint r_min;
+  uint r_max;
+
+  size_t slice_size() const { return (size_t)width * height; }
+  uint radii() const { return r_max - r_min + 1; }
+};
+
+// Distinct pixel offsets (dx, dy) on the rasterized circle of radius r
+void CircleOffsets(uint r, std::vector<int> &dx, std::vector<int> &dy);
+
+// Host reference: votes[(b*width + a)] for one radius, by scattering every edge pixel
+void CircleReference(const CircleSize &size, const char pixels[], uint r, short votes[]);
+
+// Submit the votes of one radius into slice_buf, every slice entry is written.
+// The centre (a, b) counts the edge pixels at (a+dx, b+dy) for the offsets of radius r,
+// gathering instead of scattering so no two work-items write the same entry.
+event SubmitCircleVoting(queue &device_queue, HoughKernel kernel, const CircleSize &size, uint r,
+                         buffer<char, 1> &pixels_buf, buffer<int, 1> &offsets_buf, uint samples,
+                         buffer<short, 1> &slice_buf);
+
+// The k strongest circles over all radii (StrongerCircle), strongest first, each a local maximum
+// in its radius slice.
+// Only k circles per radius are copied back to the host.
+std::vector<HoughCircle> FindHoughCircles(const CircleSize &size, const char pixels[], uint k, uint threshold,
+                                          HoughKernel kernel = HoughKernel::automatic);
@@ -0,0 +1,104 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include "hough_incremental.hpp"
+
+class Hough_incremental_kernel;
+
+void DiffEdges(const HoughSize &size, const char before[], const char after[],
+               std::vector<uint32_t> &added, std::vector<uint32_t> &removed)
+{
+    added.clear();
+    removed.clear();
+    for (uint y = 0; y < size.height; y++) {
+      for (uint x = 0; x < size.width; x++) {
+        size_t i = (size_t)y*size.width+x;
+        if (!before[i] && after[i]) added.push_back(PackEdge(x, y));
+        if (before[i] && !after[i]) removed.push_back(PackEdge(x, y));
+      }
+    }
+}
+
+HoughIncremental::HoughIncremental(const HoughSize &size, HoughKernel kernel)
+    : size(size), device_queue(MakeHoughQueue()), kernel(ResolveHoughKernel(device_queue, kernel)),
+      sinvals(TrigTable(size.thetas, true)), cosvals(TrigTable(size.thetas, false)),
+      sin_table_buf(sinvals.begin(), sinvals.end()), cos_table_buf(cosvals.begin(), cosvals.end()),
+      accumulators_buf{range<1>{size.accumulator_size()}},
+      partial_buf{range<1>{HoughPartialSize(device_queue, this->kernel, size)}},
+      candidates_buf{range<1>{PEAK_CHUNKS*MAX_PEAKS}}
+{
+    // Start from an empty accumulator
+    device_queue.submit([&](sycl::handler &cgh) {
+      auto _accumulators = accumulators_buf.get_access<sycl::access::mode::discard_write>(cgh);
+      cgh.fill(_accumulators, (short)0);
+    });
+}
+
+void HoughIncremental::Reset(const char pixels[])
+{
+    buffer<char, 1> pixels_buf(pixels, range<1>{size.image_size()});
+    SubmitHoughVoting(device_queue, kernel, size, pixels_buf, sin_table_buf, cos_table_buf,
+                      accumulators_buf, partial_buf);
+}
+
+double HoughIncremental::Update(const std::vector<uint32_t> &added, const std::vector<uint32_t> &removed)
+{
+    size_t num_added = added.size();
+    size_t num_edges = num_added + removed.size();
+    if (num_edges == 0) return 0;
+
+    // One upload of both lists, the removed pixels follow the added ones
+    std::vector<uint32_t> edges(added);
+    edges.insert(edges.end(), removed.begin(), removed.end());
+    buffer<uint32_t, 1> edges_buf(edges.data(), range<1>{num_edges});
+
+    uint thetas = size.thetas;
+    int rhos = size.rhos;
+
+    // Each work-item owns one theta column, so +1/-1 votes never collide and need no atomics
+    event queue_event = device_queue.submit([&](sycl::handler &cgh) {
+      auto _edges = edges_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _sin_table = sin_table_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _cos_table = cos_table_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _accumulators = accumulators_buf.get_access<sycl::access::mode::read_write>(cgh);
+
+      cgh.parallel_for<class Hough_incremental_kernel>(range<1>{thetas}, [=](id<1> t) {
+        uint theta = t[0];
+        float cos_theta = _cos_table[theta];
+        float sin_theta = _sin_table[theta];
+        for (size_t e = 0; e < num_edges; e++) {
+          uint x = _edges[e] & 0xFFFF;
+          uint y = _edges[e] >> 16;
+          int rho = x*cos_theta + y*sin_theta;
+          _accumulators[(size_t)(rho+rhos)*thetas+theta] += (e < num_added) ? 1 : -1;
+        }
+      });
+    });
+    queue_event.wait();
+
+    cl_ulong t1_kernel = queue_event.get_profiling_info<sycl::info::event_profiling::command_start>();
+    cl_ulong t2_kernel = queue_event.get_profiling_info<sycl::info::event_profiling::command_end>();
+    return (t2_kernel - t1_kernel) / NS;
+}
+
+void HoughIncremental::Read(short accumulators[])
+{
+    device_queue.submit([&](sycl::handler &cgh) {
+      auto _accumulators = accumulators_buf.get_access<sycl::access::mode::read>(cgh);
+      cgh.copy(_accumulators, accumulators);
+    }).wait();
+}
+
+std::vector<HoughLine> HoughIncremental::Lines(uint k, uint threshold)
+{
+    std::vector<HoughLine> lines(k);
+    {
+      buffer<HoughLine, 1> lines_buf(lines.data(), range<1>{k});
+      SubmitHoughPeaks(device_queue, size, accumulators_buf, k, threshold, lines_buf, candidates_buf);
+    }
+    while (!lines.empty() && lines.back().votes == 0) lines.pop_back();
+    return lines;
+}
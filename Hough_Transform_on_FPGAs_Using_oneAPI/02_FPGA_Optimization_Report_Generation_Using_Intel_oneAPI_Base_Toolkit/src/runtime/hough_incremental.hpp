@@ -0,0 +1,48 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#pragma once
+
+#include <cstdint>
+#include "hough_peaks.hpp"
+
+// Edge pixels are passed as packed (y << 16) | x coordinates
+inline uint32_t PackEdge(uint x, uint y) { return (y << 16) | x; }
+
+// Edge pixels set in after but not in before (added) and the reverse (removed)
+void DiffEdges(const HoughSize &size, const char before[], const char after[],
+               std::vector<uint32_t> &added, std::vector<uint32_t> &removed);
+
+// Hough accumulator that stays on the device between frames. After one full
+// vote, frames that differ in a few edge pixels are applied as +1/-1 votes for
+// the changed pixels only, so the cost follows the size of the change rather
+// than the size of the frame. Every added pixel must be unset and every removed
+// pixel set in the image the accumulator currently represents.
+class HoughIncremental {
+public:
+  HoughIncremental(const HoughSize &size, HoughKernel kernel = HoughKernel::automatic);
+
+  // Full vote of a frame, replaces the accumulator
+  void Reset(const char pixels[]);
+
+  // Apply the votes of added and removed edge pixels, returns the device time in seconds
+  double Update(const std::vector<uint32_t> &added, const std::vector<uint32_t> &removed);
+
+  // Copy the whole accumulator to the host
+  void Read(short accumulators[]);
+
+  // Peak detection on the persistent accumulator, only the k lines are copied back
+  std::vector<HoughLine> Lines(uint k, uint threshold);
+
+private:
+  HoughSize size;
+  queue device_queue;
+  HoughKernel kernel;
+  std::vector<float> sinvals, cosvals;
+  buffer<float, 1> sin_table_buf, cos_table_buf;
+  buffer<short, 1> accumulators_buf, partial_buf;
+  buffer<uint64_t, 1> candidates_buf;
+};
@@ -0,0 +1,121 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <stdexcept>
+#include "hough_peaks.hpp"
+
+class Hough_peaks_kernel;
+
+// Accumulator index to (rho, theta)
+struct LineDecoder {
+  uint thetas;
+  int rhos;
+
+  HoughLine operator()(uint64_t key) const {
+    uint votes = PeakVotes(key);
+    size_t index = PeakIndex(key);
+    HoughLine line;
+    line.rho = votes ? (int)(index / thetas) - rhos : 0;
+    line.theta = votes ? index % thetas : 0;
+    line.votes = votes;
+    return line;
+  }
+};
+
+event SubmitPeakCandidates(queue &device_queue, size_t rows, size_t cols, buffer<short, 1> &grid_buf,
+                           uint k, uint threshold, buffer<uint64_t, 1> &candidates_buf)
+{
+    if (k == 0 || k > MAX_PEAKS) {
+      throw std::invalid_argument("k must be in [1, MAX_PEAKS]");
+    }
+
+    size_t grid_size = rows * cols;
+    size_t chunk = (grid_size + PEAK_CHUNKS - 1) / PEAK_CHUNKS;
+    if (threshold == 0) threshold = 1;
+
+    return device_queue.submit([&](sycl::handler &cgh) {
+      auto _grid = grid_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _candidates = candidates_buf.get_access<sycl::access::mode::discard_write>(cgh);
+
+      cgh.parallel_for<class Hough_peaks_kernel>(range<1>{PEAK_CHUNKS}, [=](id<1> c) {
+        uint64_t top[MAX_PEAKS];
+        for (uint i = 0; i < k; i++) top[i] = 0;
+
+        size_t begin = c[0] * chunk;
+        size_t end = (begin + chunk < grid_size) ? begin + chunk : grid_size;
+        for (size_t index = begin; index < end; index++) {
+          int votes = _grid[index];
+          if (votes < (int)threshold) continue;
+
+          // Non-maximum suppression: strictly above earlier neighbours, at least equal to later
+          // ones, so a plateau yields exactly one peak
+          long row = index / cols;
+          long col = index % cols;
+          bool peak = true;
+          for (int dr = -1; dr <= 1 && peak; dr++) {
+            for (int dc = -1; dc <= 1 && peak; dc++) {
+              long r = row + dr, t = col + dc;
+              if ((dr == 0 && dc == 0) || r < 0 || r >= (long)rows || t < 0 || t >= (long)cols) continue;
+              int neighbour = _grid[(size_t)r*cols+t];
+              bool earlier = dr < 0 || (dr == 0 && dc < 0);
+              peak = earlier ? votes > neighbour : votes >= neighbour;
+            }
+          }
+          if (peak) InsertTopK(top, k, PeakKey(votes, index));
+        }
+
+        for (uint i = 0; i < k; i++) _candidates[c[0]*MAX_PEAKS+i] = top[i];
+      });
+    });
+}
+
+std::vector<event> SubmitHoughPeaks(queue &device_queue, const HoughSize &size, buffer<short, 1> &accumulators_buf,
+                                    uint k, uint threshold, buffer<HoughLine, 1> &lines_buf,
+                                    buffer<uint64_t, 1> &candidates_buf)
+{
+    LineDecoder decode{size.thetas, (int)size.rhos};
+    return {SubmitPeakCandidates(device_queue, (size_t)size.rhos*2, size.thetas, accumulators_buf, k, threshold,
+                                 candidates_buf),
+            SubmitPeakMerge(device_queue, k, candidates_buf, decode, lines_buf, 0)};
+}
+
+std::vector<HoughLine> FindHoughLines(const HoughSize &size, const char pixels[], uint k, uint threshold,
+                                      HoughKernel kernel)
+{
+    std::vector<float> sinvals, cosvals;
+    MakeTrigTables(size.thetas, sinvals, cosvals);
+    std::vector<HoughLine> lines(k);
+
+    {
+      buffer<char, 1> pixels_buf(pixels, range<1>{size.image_size()});
+      buffer<float, 1> sin_table_buf(sinvals.begin(), sinvals.end());
+      buffer<float, 1> cos_table_buf(cosvals.begin(), cosvals.end());
+      // The accumulator only exists on the device
+      buffer<short, 1> accumulators_buf{range<1>{size.accumulator_size()}};
+      buffer<uint64_t, 1> candidates_buf{range<1>{PEAK_CHUNKS*MAX_PEAKS}};
+      buffer<HoughLine, 1> lines_buf(lines.data(), range<1>{k});
+
+      queue device_queue = MakeHoughQueue();
+      buffer<short, 1> partial_buf{range<1>{HoughPartialSize(device_queue, kernel, size)}};
+
+      std::vector<event> voting = SubmitHoughVoting(device_queue, kernel, size, pixels_buf, sin_table_buf,
+                                                    cos_table_buf, accumulators_buf, partial_buf);
+      std::vector<event> peaks = SubmitHoughPeaks(device_queue, size, accumulators_buf, k, threshold,
+                                                  lines_buf, candidates_buf);
+
+      // Report voting and peak detection time
+      double time_voting = (voting.back().get_profiling_info<sycl::info::event_profiling::command_end>() -
+                            voting.front().get_profiling_info<sycl::info::event_profiling::command_start>()) / NS;
+      double time_peaks = (peaks.back().get_profiling_info<sycl::info::event_profiling::command_end>() -
+                           peaks.front().get_profiling_info<sycl::info::event_profiling::command_start>()) / NS;
+      std::cout << "Voting time: " << time_voting << " seconds" << std::endl;
+      std::cout << "Peak detection time: " << time_peaks << " seconds" << std::endl;
+    }
+
+    // Drop the unused slots when fewer than k peaks were found
+    while (!lines.empty() && lines.back().votes == 0) lines.pop_back();
+    return lines;
+}
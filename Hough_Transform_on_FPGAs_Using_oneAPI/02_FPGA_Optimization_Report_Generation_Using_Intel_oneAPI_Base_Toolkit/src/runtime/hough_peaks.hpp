@@ -0,0 +1,90 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#pragma once
+
+#include <cstdint>
+#include "hough_transform_kernel.hpp"
+
+#define MAX_PEAKS 64 // Largest K supported by the top-K selection
+#define PEAK_CHUNKS 256 // Accumulator chunks scanned in parallel before the final merge
+
+// One detected line, rho in [-rhos, rhos), theta in steps of 180/thetas degrees
+struct HoughLine {
+  int rho;
+  uint theta;
+  uint votes;
+};
+
+// Top-k selection shared by line and circle detection.
+// Candidates are packed as votes in the high word and the inverted grid index in the
+// low word, so a larger key is a stronger peak and equal votes prefer the lower index
+inline uint64_t PeakKey(uint votes, size_t index)
+{
+    return ((uint64_t)votes << 32) | (uint32_t)(0xFFFFFFFFu - index);
+}
+
+inline uint PeakVotes(uint64_t key) { return key >> 32; }
+inline size_t PeakIndex(uint64_t key) { return 0xFFFFFFFFu - (uint32_t)key; }
+
+// Insert key into list[0..k), kept sorted in descending order
+inline void InsertTopK(uint64_t list[MAX_PEAKS], uint k, uint64_t key)
+{
+    if (key <= list[k-1]) return;
+    uint i = k - 1;
+    while (i > 0 && list[i-1] < key) {
+      list[i] = list[i-1];
+      i--;
+    }
+    list[i] = key;
+}
+
+// Local maxima over a 3x3 neighbourhood of a rows x cols grid with at least threshold votes.
+// Every one of PEAK_CHUNKS chunks writes its k strongest keys to candidates_buf[chunk*MAX_PEAKS ...],
+// no atomics or global ordering needed.
+event SubmitPeakCandidates(queue &device_queue, size_t rows, size_t cols, buffer<short, 1> &grid_buf,
+                           uint k, uint threshold, buffer<uint64_t, 1> &candidates_buf);
+
+template <typename Decoder>
+class Peak_merge_kernel;
+
+// Merge the per-chunk candidates into the k strongest, decode(key) converts each key
+// (0 for an unused slot) into out_buf[offset + i]
+template <typename Decoder, typename T>
+event SubmitPeakMerge(queue &device_queue, uint k, buffer<uint64_t, 1> &candidates_buf, Decoder decode,
+                      buffer<T, 1> &out_buf, size_t offset)
+{
+    return device_queue.submit([&](sycl::handler &cgh) {
+      auto _candidates = candidates_buf.template get_access<sycl::access::mode::read>(cgh);
+      auto _out = out_buf.template get_access<sycl::access::mode::write>(cgh);
+
+      cgh.single_task<Peak_merge_kernel<Decoder>>([=]() {
+        uint64_t top[MAX_PEAKS];
+        for (uint i = 0; i < k; i++) top[i] = 0;
+
+        for (uint c = 0; c < PEAK_CHUNKS; c++) {
+          for (uint i = 0; i < k; i++) {
+            uint64_t key = _candidates[c*MAX_PEAKS+i];
+            if (key <= top[k-1]) break;
+            InsertTopK(top, k, key);
+          }
+        }
+
+        for (uint i = 0; i < k; i++) _out[offset+i] = decode(top[i]);
+      });
+    });
+}
+
+// Local maxima of the accumulator over a 3x3 (rho, theta) neighbourhood with at least
+// threshold votes, the k strongest are written to lines_buf in descending order.
+// Unused entries of lines_buf have votes == 0. candidates_buf holds PEAK_CHUNKS*MAX_PEAKS keys.
+std::vector<event> SubmitHoughPeaks(queue &device_queue, const HoughSize &size, buffer<short, 1> &accumulators_buf,
+                                    uint k, uint threshold, buffer<HoughLine, 1> &lines_buf,
+                                    buffer<uint64_t, 1> &candidates_buf);
+
+// Voting followed by peak detection, only the k lines are copied back to the host
+std::vector<HoughLine> FindHoughLines(const HoughSize &size, const char pixels[], uint k, uint threshold,
+                                      HoughKernel kernel = HoughKernel::automatic);
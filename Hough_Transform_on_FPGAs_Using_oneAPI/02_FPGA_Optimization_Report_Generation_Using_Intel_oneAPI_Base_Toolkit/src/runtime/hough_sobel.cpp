@@ -0,0 +1,151 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <stdexcept>
+#include "hough_sobel.hpp"
+
+class Sobel_single_task_kernel;
+class Sobel_ndrange_kernel;
+
+// |Gx| + |Gy| over the 3x3 window p[row][col]
+static inline bool SobelEdge(const int p[3][3], uint threshold)
+{
+    int gx = (p[0][2] + 2*p[1][2] + p[2][2]) - (p[0][0] + 2*p[1][0] + p[2][0]);
+    int gy = (p[2][0] + 2*p[2][1] + p[2][2]) - (p[0][0] + 2*p[0][1] + p[0][2]);
+    int magnitude = (gx < 0 ? -gx : gx) + (gy < 0 ? -gy : gy);
+    return magnitude > (int)threshold;
+}
+
+void SobelReference(const HoughSize &size, const uint8_t gray[], uint threshold, char pixels[])
+{
+    uint width = size.width, height = size.height;
+    for (uint y = 0; y < height; y++) {
+      for (uint x = 0; x < width; x++) {
+        bool edge = false;
+        if (x > 0 && y > 0 && x + 1 < width && y + 1 < height) {
+          int p[3][3];
+          for (int r = 0; r < 3; r++)
+            for (int c = 0; c < 3; c++)
+              p[r][c] = gray[(size_t)(y+r-1)*width + x+c-1];
+          edge = SobelEdge(p, threshold);
+        }
+        pixels[(size_t)y*width+x] = edge;
+      }
+    }
+}
+
+event SubmitSobel(queue &device_queue, HoughKernel kernel, const HoughSize &size, buffer<uint8_t, 1> &gray_buf,
+                  uint threshold, buffer<char, 1> &pixels_buf)
+{
+    uint width = size.width;
+    uint height = size.height;
+
+    if (ResolveHoughKernel(device_queue, kernel) == HoughKernel::single_task) {
+      if (width > MAX_WIDTH) {
+        throw std::invalid_argument("image width exceeds MAX_WIDTH");
+      }
+
+      return device_queue.submit([&](sycl::handler &cgh) {
+        auto _gray = gray_buf.get_access<sycl::access::mode::read>(cgh);
+        auto _pixels = pixels_buf.get_access<sycl::access::mode::discard_write>(cgh);
+
+        cgh.single_task<class Sobel_single_task_kernel>([=]() [[intel::kernel_args_restrict]] {
+          // Every input pixel is read once: the two previous rows live in the line buffer,
+          // the 3x3 window shifts left by one column per pixel
+          uint8_t line_buffer[2][MAX_WIDTH];
+          int window[3][3];
+
+          for (uint y = 0; y < height; y++) {
+            for (uint x = 0; x < width; x++) {
+              int incoming = _gray[(size_t)y*width+x];
+              int above = line_buffer[1][x];
+              int above2 = line_buffer[0][x];
+              line_buffer[0][x] = above;
+              line_buffer[1][x] = incoming;
+
+              #pragma unroll
+              for (int r = 0; r < 3; r++) {
+                window[r][0] = window[r][1];
+                window[r][1] = window[r][2];
+              }
+              window[0][2] = above2;
+              window[1][2] = above;
+              window[2][2] = incoming;
+
+              // The window is centred on (x-1, y-1), write that pixel once its neighbourhood is complete
+              if (y >= 2 && x >= 2) {
+                _pixels[(size_t)(y-1)*width + x-1] = SobelEdge(window, threshold);
+              }
+              // Border pixels are never edges
+              if (y == 0 || y == height-1 || x == 0 || x == width-1) {
+                _pixels[(size_t)y*width+x] = 0;
+              }
+            }
+          }
+        });
+      });
+    }
+
+    return device_queue.submit([&](sycl::handler &cgh) {
+      auto _gray = gray_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _pixels = pixels_buf.get_access<sycl::access::mode::discard_write>(cgh);
+
+      cgh.parallel_for<class Sobel_ndrange_kernel>(range<2>{height, width}, [=](id<2> idx) {
+        uint y = idx[0], x = idx[1];
+        bool edge = false;
+        if (x > 0 && y > 0 && x + 1 < width && y + 1 < height) {
+          int p[3][3];
+          for (int r = 0; r < 3; r++)
+            for (int c = 0; c < 3; c++)
+              p[r][c] = _gray[(size_t)(y+r-1)*width + x+c-1];
+          edge = SobelEdge(p, threshold);
+        }
+        _pixels[(size_t)y*width+x] = edge;
+      });
+    });
+}
+
+std::vector<HoughLine> DetectLines(const HoughSize &size, const uint8_t gray[], uint edge_threshold, uint k,
+                                   uint vote_threshold, HoughKernel kernel)
+{
+    std::vector<float> sinvals, cosvals;
+    MakeTrigTables(size.thetas, sinvals, cosvals);
+    std::vector<HoughLine> lines(k);
+
+    {
+      buffer<uint8_t, 1> gray_buf(gray, range<1>{size.image_size()});
+      buffer<float, 1> sin_table_buf(sinvals.begin(), sinvals.end());
+      buffer<float, 1> cos_table_buf(cosvals.begin(), cosvals.end());
+      // Edge map and accumulator only exist on the device
+      buffer<char, 1> pixels_buf{range<1>{size.image_size()}};
+      buffer<short, 1> accumulators_buf{range<1>{size.accumulator_size()}};
+      buffer<uint64_t, 1> candidates_buf{range<1>{PEAK_CHUNKS*MAX_PEAKS}};
+      buffer<HoughLine, 1> lines_buf(lines.data(), range<1>{k});
+
+      queue device_queue = MakeHoughQueue();
+      buffer<short, 1> partial_buf{range<1>{HoughPartialSize(device_queue, kernel, size)}};
+
+      event sobel = SubmitSobel(device_queue, kernel, size, gray_buf, edge_threshold, pixels_buf);
+      std::vector<event> voting = SubmitHoughVoting(device_queue, kernel, size, pixels_buf, sin_table_buf,
+                                                    cos_table_buf, accumulators_buf, partial_buf);
+      std::vector<event> peaks = SubmitHoughPeaks(device_queue, size, accumulators_buf, k, vote_threshold,
+                                                  lines_buf, candidates_buf);
+
+      // Report the time of every stage
+      double time_sobel = (sobel.get_profiling_info<sycl::info::event_profiling::command_end>() -
+                           sobel.get_profiling_info<sycl::info::event_profiling::command_start>()) / NS;
+      double time_voting = (voting.back().get_profiling_info<sycl::info::event_profiling::command_end>() -
+                            voting.front().get_profiling_info<sycl::info::event_profiling::command_start>()) / NS;
+      double time_peaks = (peaks.back().get_profiling_info<sycl::info::event_profiling::command_end>() -
+                           peaks.front().get_profiling_info<sycl::info::event_profiling::command_start>()) / NS;
+      std::cout << "Sobel time: " << time_sobel << " seconds" << std::endl;
+      std::cout << "Voting time: " << time_voting << " seconds" << std::endl;
+      std::cout << "Peak detection time: " << time_peaks << " seconds" << std::endl;
+    }
+
+    while (!lines.empty() && lines.back().votes == 0) lines.pop_back();
+    return lines;
+}
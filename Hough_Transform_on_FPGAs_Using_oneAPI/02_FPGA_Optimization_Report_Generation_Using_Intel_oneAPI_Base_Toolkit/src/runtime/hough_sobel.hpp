@@ -0,0 +1,27 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#pragma once
+
+#include <cstdint>
+#include "hough_peaks.hpp"
+
+#define MAX_WIDTH 2048 // Longest row held in the line buffer of the single_task Sobel kernel
+
+// Host reference: pixels[i] = 1 where |Gx|+|Gy| of the 3x3 Sobel operator exceeds threshold,
+// border pixels are 0
+void SobelReference(const HoughSize &size, const uint8_t gray[], uint threshold, char pixels[]);
+
+// Device Sobel/threshold stage producing the binary edge map consumed by SubmitHoughVoting.
+// single_task: one pass over the image with a two-row line buffer, for FPGA
+// nd_range:    one work-item per pixel, for CPU/GPU
+event SubmitSobel(queue &device_queue, HoughKernel kernel, const HoughSize &size, buffer<uint8_t, 1> &gray_buf,
+                  uint threshold, buffer<char, 1> &pixels_buf);
+
+// Raw grayscale frame in, lines out: one upload, Sobel, voting and peak detection back to back
+// on the device, only the k lines are copied back
+std::vector<HoughLine> DetectLines(const HoughSize &size, const uint8_t gray[], uint edge_threshold, uint k,
+                                   uint vote_threshold, HoughKernel kernel = HoughKernel::automatic);
@@ -0,0 +1,76 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include "hough_stream.hpp"
+
+HoughFrame::HoughFrame(const HoughSize &size, uint peaks)
+    : pixels(size.image_size()), accumulators(peaks ? 0 : size.accumulator_size()), lines(peaks),
+      pixels_buf{range<1>{size.image_size()}}, accumulators_buf{range<1>{size.accumulator_size()}},
+      lines_buf{range<1>{peaks ? peaks : 1}} {}
+
+HoughStream::HoughStream(const HoughSize &size, uint peaks, uint threshold, HoughKernel kernel)
+    : size(size), device_queue(MakeHoughQueue()), kernel(ResolveHoughKernel(device_queue, kernel)),
+      peaks(peaks), threshold(threshold), sinvals(TrigTable(size.thetas, true)), cosvals(TrigTable(size.thetas, false)),
+      sin_table_buf(sinvals.begin(), sinvals.end()), cos_table_buf(cosvals.begin(), cosvals.end()),
+      partial_buf{range<1>{HoughPartialSize(device_queue, this->kernel, size)}},
+      candidates_buf{range<1>{PEAK_CHUNKS*MAX_PEAKS}}
+{
+    frames.emplace_back(size, peaks);
+    frames.emplace_back(size, peaks);
+}
+
+HoughStream::~HoughStream()
+{
+    Finish();
+}
+
+void HoughStream::Complete(HoughFrame &frame)
+{
+    if (!frame.pending) return;
+    frame.download.wait();
+    frame.pending = false;
+
+    cl_ulong t1 = frame.upload.get_profiling_info<sycl::info::event_profiling::command_start>();
+    cl_ulong t2 = frame.download.get_profiling_info<sycl::info::event_profiling::command_end>();
+    latencies.push_back((t2 - t1) / NS);
+}
+
+HoughFrame &HoughStream::Acquire(int i)
+{
+    HoughFrame &frame = frames[i % 2];
+    Complete(frame);
+    return frame;
+}
+
+void HoughStream::Submit(HoughFrame &frame)
+{
+    frame.upload = device_queue.submit([&](sycl::handler &cgh) {
+      auto _pixels = frame.pixels_buf.get_access<sycl::access::mode::discard_write>(cgh);
+      cgh.copy(frame.pixels.data(), _pixels);
+    });
+
+    SubmitHoughVoting(device_queue, kernel, size, frame.pixels_buf, sin_table_buf, cos_table_buf,
+                      frame.accumulators_buf, partial_buf);
+
+    if (peaks) {
+      SubmitHoughPeaks(device_queue, size, frame.accumulators_buf, peaks, threshold, frame.lines_buf, candidates_buf);
+      frame.download = device_queue.submit([&](sycl::handler &cgh) {
+        auto _lines = frame.lines_buf.get_access<sycl::access::mode::read>(cgh);
+        cgh.copy(_lines, frame.lines.data());
+      });
+    } else {
+      frame.download = device_queue.submit([&](sycl::handler &cgh) {
+        auto _accumulators = frame.accumulators_buf.get_access<sycl::access::mode::read>(cgh);
+        cgh.copy(_accumulators, frame.accumulators.data());
+      });
+    }
+    frame.pending = true;
+}
+
+void HoughStream::Finish()
+{
+    for (auto &frame : frames) Complete(frame);
+}
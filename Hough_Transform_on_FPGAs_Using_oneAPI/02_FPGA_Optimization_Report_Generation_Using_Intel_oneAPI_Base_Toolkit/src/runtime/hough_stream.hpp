@@ -0,0 +1,60 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#pragma once
+
+#include "hough_peaks.hpp"
+
+// Streaming Hough transform for a sequence of frames of one size.
+// The queue, trig tables and device buffers are created once. Two frame slots
+// are used so the host fills and reads one slot while the device uploads,
+// votes and downloads the other. The accumulator is never sent to the device,
+// the voting kernels overwrite it on the device for every frame.
+// With peaks > 0 only the strongest lines are downloaded instead of the accumulator.
+struct HoughFrame {
+  std::vector<char> pixels;        // filled by the host before Submit
+  std::vector<short> accumulators; // valid once the slot has been acquired again (peaks == 0)
+  std::vector<HoughLine> lines;    // valid once the slot has been acquired again (peaks > 0)
+  buffer<char, 1> pixels_buf;
+  buffer<short, 1> accumulators_buf;
+  buffer<HoughLine, 1> lines_buf;
+  event upload, download;
+  bool pending = false;
+
+  HoughFrame(const HoughSize &size, uint peaks);
+};
+
+class HoughStream {
+public:
+  HoughStream(const HoughSize &size, uint peaks = 0, uint threshold = 1, HoughKernel kernel = HoughKernel::automatic);
+  ~HoughStream();
+
+  // Waits until the slot used by frame i is free, its accumulators hold the results of frame i-2
+  HoughFrame &Acquire(int i);
+
+  // Upload, vote and download one frame, returns without waiting
+  void Submit(HoughFrame &frame);
+
+  // Waits for every submitted frame
+  void Finish();
+
+  // Device time from the start of the upload to the end of the download, one entry per completed frame
+  const std::vector<double> &Latencies() const { return latencies; }
+
+private:
+  void Complete(HoughFrame &frame);
+
+  HoughSize size;
+  queue device_queue;
+  HoughKernel kernel;
+  uint peaks, threshold;
+  std::vector<float> sinvals, cosvals;
+  buffer<float, 1> sin_table_buf, cos_table_buf;
+  buffer<short, 1> partial_buf;
+  buffer<uint64_t, 1> candidates_buf;
+  std::vector<HoughFrame> frames;
+  std::vector<double> latencies;
+};
@@ -0,0 +1,303 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "hough_transform_kernel.hpp"
+
+class Hough_runtime_kernel;
+class Hough_ndrange_kernel;
+class Hough_merge_kernel;
+
+HoughSize MakeHoughSize(uint width, uint height, uint thetas)
+{
+    HoughSize size;
+    size.width = width;
+    size.height = height;
+    size.thetas = thetas;
+    size.rhos = (uint)std::ceil(std::sqrt((double)width*width + (double)height*height));
+    return size;
+}
+
+void MakeTrigTables(uint thetas, std::vector<float> &sinvals, std::vector<float> &cosvals)
+{
+    sinvals.resize(thetas);
+    cosvals.resize(thetas);
+    for (uint theta=0; theta<thetas; theta++) {
+      double radians = theta * M_PI / thetas;
+      sinvals[theta] = (float)std::sin(radians);
+      cosvals[theta] = (float)std::cos(radians);
+    }
+}
+
+std::vector<float> TrigTable(uint thetas, bool sine)
+{
+    std::vector<float> sinvals, cosvals;
+    MakeTrigTables(thetas, sinvals, cosvals);
+    return sine ? sinvals : cosvals;
+}
+
+queue MakeHoughQueue()
+{
+    auto my_property_list = property_list{sycl::property::queue::enable_profiling()};
+
+    // Device selection: Explicitly compile for the FPGA_EMULATOR, FPGA or any other device
+    #if defined(FPGA_EMULATOR)
+        INTEL::fpga_emulator_selector device_selector;
+    #elif defined(NDRANGE_DEVICE)
+        default_selector device_selector;
+    #else
+        INTEL::fpga_selector device_selector;
+    #endif
+
+    try {
+        queue device_queue(device_selector,NULL,my_property_list);
+        platform platform = device_queue.get_context().get_platform();
+        device my_device = device_queue.get_device();
+        std::cout << "Platform name: " <<  platform.get_info<sycl::info::platform::name>().c_str() << std::endl;
+        std::cout << "Device name: " <<  my_device.get_info<sycl::info::device::name>().c_str() << std::endl;
+        return device_queue;
+    } catch (sycl::exception const &e) {
+        // Catches exceptions in the host code
+        std::cout << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+        // Most likely the runtime could not find FPGA hardware!
+        if (e.get_cl_code() == CL_DEVICE_NOT_FOUND) {
+          std::cout << "If you are targeting an FPGA, ensure that your "
+                       "system has a correctly configured FPGA board.\n";
+          std::cout << "If you are targeting the FPGA emulator, compile with "
+                       "-DFPGA_EMULATOR.\n";
+        }
+        std::terminate();
+    }
+}
+
+HoughKernel ResolveHoughKernel(const queue &device_queue, HoughKernel kernel)
+{
+    if (kernel != HoughKernel::automatic) return kernel;
+    return device_queue.get_device().is_accelerator() ? HoughKernel::single_task : HoughKernel::nd_range;
+}
+
+static event SubmitSingleTask(queue &device_queue, const HoughSize &size, buffer<char, 1> &pixels_buf,
+                              buffer<float, 1> &sin_table_buf, buffer<float, 1> &cos_table_buf,
+                              buffer<short, 1> &accumulators_buf)
+{
+    // The local accumulator is sized at compile time, larger images need a larger MAX_RHOS
+    if (size.rhos > MAX_RHOS) {
+      throw std::invalid_argument("image diagonal exceeds MAX_RHOS");
+    }
+
+    uint width = size.width;
+    uint height = size.height;
+    uint thetas = size.thetas;
+    int rhos = size.rhos;
+
+    return device_queue.submit([&](sycl::handler &cgh) {
+      // Create accessors
+      auto _pixels = pixels_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _sin_table = sin_table_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _cos_table = cos_table_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _accumulators = accumulators_buf.get_access<sycl::access::mode::discard_write>(cgh);
+
+      //Call the kernel
+      cgh.single_task<class Hough_runtime_kernel>([=]() [[intel::kernel_args_restrict]] {
+
+        // Banked local accumulator holds THETA_BLOCK thetas for every rho,
+        // the image is streamed once per block of thetas
+        [[intel::numbanks(THETA_BLOCK)]]
+        short accum_local[MAX_RHOS*2][THETA_BLOCK];
+
+        for (uint theta0=0; theta0<thetas; theta0+=THETA_BLOCK) {
+          uint block = (thetas - theta0 < THETA_BLOCK) ? thetas - theta0 : THETA_BLOCK;
+
+          for (int i = 0; i < rhos*2; i++) {
+            for (int j=0; j<THETA_BLOCK; j++) {
+              accum_local[i][j] = 0;
+            }
+          }
+          for (uint y=0; y<height; y++) {
+            for (uint x=0; x<width; x++) {
+              if (_pixels[(size_t)width*y+x] == 0) continue;
+
+              #pragma unroll
+              [[intel::ivdep]]
+              for (int j=0; j<THETA_BLOCK; j++) {
+                if (j < block) {
+                  int rho = x*_cos_table[theta0+j] + y*_sin_table[theta0+j];
+                  accum_local[rho+rhos][j] += 1;
+                }
+              }
+            }
+          }
+          //Store from local to global memory
+          for (int i = 0; i < rhos*2; i++) {
+            for (uint j=0; j<block; j++) {
+              _accumulators[(size_t)i*thetas+theta0+j] = accum_local[i][j];
+            }
+          }
+        }
+
+      });
+    });
+}
+
+// Work decomposition of the nd_range kernel
+struct NDRangeShape {
+  size_t group_thetas; // theta columns held in local memory by one work-group
+  size_t theta_groups;
+  size_t bands;        // row bands voted independently, summed by the merge kernel
+  size_t band_rows;
+};
+
+static NDRangeShape MakeNDRangeShape(const device &my_device, const HoughSize &size)
+{
+    size_t local_mem_size = my_device.get_info<info::device::local_mem_size>();
+    size_t max_wg_size = my_device.get_info<info::device::max_work_group_size>();
+
+    // A work-group holds group_thetas full theta columns of the accumulator in local memory,
+    // each work-item owns one column so votes never collide and need no atomics
+    NDRangeShape shape;
+    size_t column_bytes = (size_t)size.rhos * 2 * sizeof(short);
+    shape.group_thetas = std::min({(size_t)size.thetas, max_wg_size, local_mem_size / column_bytes});
+    if (shape.group_thetas == 0) {
+      throw std::invalid_argument("one accumulator column does not fit in local memory");
+    }
+    shape.theta_groups = (size.thetas + shape.group_thetas - 1) / shape.group_thetas;
+
+    // Row bands give every theta range several independent work-groups
+    shape.bands = std::min<size_t>(size.height, MAX_BANDS);
+    shape.band_rows = (size.height + shape.bands - 1) / shape.bands;
+    shape.bands = (size.height + shape.band_rows - 1) / shape.band_rows;
+    return shape;
+}
+
+size_t HoughPartialSize(const queue &device_queue, HoughKernel kernel, const HoughSize &size)
+{
+    if (ResolveHoughKernel(device_queue, kernel) == HoughKernel::single_task) return 1;
+    NDRangeShape shape = MakeNDRangeShape(device_queue.get_device(), size);
+    return shape.bands == 1 ? 1 : shape.bands * size.accumulator_size();
+}
+
+static std::vector<event> SubmitNDRange(queue &device_queue, const HoughSize &size, buffer<char, 1> &pixels_buf,
+                                        buffer<float, 1> &sin_table_buf, buffer<float, 1> &cos_table_buf,
+                                        buffer<short, 1> &accumulators_buf, buffer<short, 1> &partial_buf)
+{
+    NDRangeShape shape = MakeNDRangeShape(device_queue.get_device(), size);
+    size_t group_thetas = shape.group_thetas;
+    size_t theta_groups = shape.theta_groups;
+    size_t bands = shape.bands;
+    size_t band_rows = shape.band_rows;
+
+    uint width = size.width;
+    uint height = size.height;
+    uint thetas = size.thetas;
+    int rhos = size.rhos;
+    size_t accumulator_size = size.accumulator_size();
+
+    buffer<short, 1> &votes_buf = (bands == 1) ? accumulators_buf : partial_buf;
+
+    std::vector<event> events;
+    events.push_back(device_queue.submit([&](sycl::handler &cgh) {
+      auto _pixels = pixels_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _sin_table = sin_table_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _cos_table = cos_table_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _votes = votes_buf.get_access<sycl::access::mode::discard_write>(cgh);
+
+      // accum_local[rho*group_thetas + j], consecutive work-items touch consecutive words
+      accessor<short, 1, access::mode::read_write, access::target::local> accum_local(range<1>(rhos*2*group_thetas), cgh);
+
+      range<2> global_size(theta_groups * group_thetas, bands);
+      range<2> work_group_size(group_thetas, 1);
+
+      cgh.parallel_for<class Hough_ndrange_kernel>(nd_range<2>{global_size, work_group_size}, [=](nd_item<2> item) {
+        const size_t j = item.get_local_id(0);
+        const size_t theta = item.get_global_id(0);
+        const size_t band = item.get_global_id(1);
+        if (theta >= thetas) return;
+
+        const float cos_theta = _cos_table[theta];
+        const float sin_theta = _sin_table[theta];
+        const uint y0 = band * band_rows;
+        const uint y1 = (y0 + band_rows < height) ? y0 + band_rows : height;
+
+        for (int i = 0; i < rhos*2; i++) {
+          accum_local[i*group_thetas+j] = 0;
+        }
+        for (uint y=y0; y<y1; y++) {
+          for (uint x=0; x<width; x++) {
+            if (_pixels[(size_t)width*y+x] != 0) {
+              int rho = x*cos_theta + y*sin_theta;
+              accum_local[(rho+rhos)*group_thetas+j] += 1;
+            }
+          }
+        }
+        //Store the owned column to this band's accumulator
+        size_t offset = band * accumulator_size;
+        for (int i = 0; i < rhos*2; i++) {
+          _votes[offset+(size_t)i*thetas+theta] = accum_local[i*group_thetas+j];
+        }
+      });
+    }));
+
+    if (bands == 1) return events;
+
+    events.push_back(device_queue.submit([&](sycl::handler &cgh) {
+      auto _partial = partial_buf.get_access<sycl::access::mode::read>(cgh);
+      auto _accumulators = accumulators_buf.get_access<sycl::access::mode::discard_write>(cgh);
+
+      cgh.parallel_for<class Hough_merge_kernel>(range<1>{accumulator_size}, [=](id<1> i) {
+        short sum = 0;
+        for (size_t band = 0; band < bands; band++) {
+          sum += _partial[band*accumulator_size+i];
+        }
+        _accumulators[i] = sum;
+      });
+    }));
+    return events;
+}
+
+std::vector<event> SubmitHoughVoting(queue &device_queue, HoughKernel kernel, const HoughSize &size,
+                                     buffer<char, 1> &pixels_buf, buffer<float, 1> &sin_table_buf,
+                                     buffer<float, 1> &cos_table_buf, buffer<short, 1> &accumulators_buf,
+                                     buffer<short, 1> &partial_buf)
+{
+    if (ResolveHoughKernel(device_queue, kernel) == HoughKernel::single_task) {
+      return {SubmitSingleTask(device_queue, size, pixels_buf, sin_table_buf, cos_table_buf, accumulators_buf)};
+    }
+    return SubmitNDRange(device_queue, size, pixels_buf, sin_table_buf, cos_table_buf, accumulators_buf, partial_buf);
+}
+
+void RunKernel(const HoughSize &size, const char pixels[], short accumulators[], HoughKernel kernel)
+{
+    std::vector<float> sinvals, cosvals;
+    MakeTrigTables(size.thetas, sinvals, cosvals);
+
+    // Buffer setup: sizes come from the image instead of compile-time macros
+    range<1> num_pixels{size.image_size()};
+    range<1> num_accumulators{size.accumulator_size()};
+    range<1> num_table_values{size.thetas};
+
+    // Create the buffers that pass data between the host and the device
+    buffer<char, 1> pixels_buf(pixels, num_pixels);
+    buffer<short, 1> accumulators_buf(accumulators, num_accumulators);
+    buffer<float, 1> sin_table_buf(sinvals.data(), num_table_values);
+    buffer<float, 1> cos_table_buf(cosvals.data(), num_table_values);
+
+    queue device_queue = MakeHoughQueue();
+    kernel = ResolveHoughKernel(device_queue, kernel);
+    std::cout << "Voting kernel: " << (kernel == HoughKernel::single_task ? "single_task" : "nd_range") << std::endl;
+
+    buffer<short, 1> partial_buf{range<1>{HoughPartialSize(device_queue, kernel, size)}};
+    std::vector<event> events = SubmitHoughVoting(device_queue, kernel, size, pixels_buf, sin_table_buf,
+                                                  cos_table_buf, accumulators_buf, partial_buf);
+
+    // Report kernel execution time from the first kernel start to the last kernel end
+    cl_ulong t1_kernel = events.front().get_profiling_info<sycl::info::event_profiling::command_start>();
+    cl_ulong t2_kernel = events.back().get_profiling_info<sycl::info::event_profiling::command_end>();
+    double time_kernel = (t2_kernel - t1_kernel) / NS;
+    std::cout << "Kernel execution time: " << time_kernel << " seconds" << std::endl;
+}
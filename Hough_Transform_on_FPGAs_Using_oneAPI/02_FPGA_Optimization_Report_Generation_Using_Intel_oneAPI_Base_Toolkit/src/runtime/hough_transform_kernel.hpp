@@ -0,0 +1,65 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#pragma once
+
+#include <vector>
+#include <CL/sycl.hpp>
+#include <CL/sycl/INTEL/fpga_extensions.hpp>
+
+#define MAX_RHOS 2304 // Largest supported image diagonal, covers 1920x1080 (sqrt(1920^2+1080^2) = 2203)
+#define THETA_BLOCK 32 // Thetas voted per pass into the banked local accumulator
+#define MAX_BANDS 16 // Row bands voted by independent work-groups in the ND-range kernel
+#define NS (1000000000.0) // number of nanoseconds in a second
+
+using namespace sycl;
+
+// Image and transform dimensions, chosen at runtime instead of the WIDTH/HEIGHT/THETAS/RHOS macros
+struct HoughSize {
+  uint width;
+  uint height;
+  uint thetas; // angle steps over [0, 180) degrees
+  uint rhos;   // image diagonal rounded up, rho covers [-rhos, rhos)
+
+  size_t image_size() const { return (size_t)width * height; }
+  size_t accumulator_size() const { return (size_t)thetas * rhos * 2; }
+};
+
+// Voting kernel selection
+//   single_task: one pipelined loop nest with a banked local accumulator, for FPGA
+//   nd_range:    every work-item owns one theta column of a local memory accumulator, for CPU/GPU
+//   automatic:   single_task on accelerators (FPGA and FPGA emulator), nd_range otherwise
+enum class HoughKernel { automatic, single_task, nd_range };
+
+HoughSize MakeHoughSize(uint width, uint height, uint thetas = 180);
+
+// sin/cos of theta*180/thetas degrees, replaces the static tables in sin_cos_values.h
+void MakeTrigTables(uint thetas, std::vector<float> &sinvals, std::vector<float> &cosvals);
+
+// One of the two tables, for initializing members
+std::vector<float> TrigTable(uint thetas, bool sine);
+
+// Device selection: -DFPGA_EMULATOR for the emulator, -DNDRANGE_DEVICE for the default CPU/GPU device,
+// the FPGA board otherwise
+queue MakeHoughQueue();
+
+HoughKernel ResolveHoughKernel(const queue &device_queue, HoughKernel kernel);
+
+// Number of shorts the caller allocates for partial_buf of SubmitHoughVoting (at least 1)
+size_t HoughPartialSize(const queue &device_queue, HoughKernel kernel, const HoughSize &size);
+
+// Submit the voting kernels, every accumulator entry is written so no clearing pass is needed.
+// partial_buf holds the per-band accumulators of the nd_range kernel, it is owned by the caller
+// so that submitting does not block on a temporary buffer.
+// Returns the submitted events in order, the last one completes the accumulator.
+std::vector<event> SubmitHoughVoting(queue &device_queue, HoughKernel kernel, const HoughSize &size,
+                                     buffer<char, 1> &pixels_buf, buffer<float, 1> &sin_table_buf,
+                                     buffer<float, 1> &cos_table_buf, buffer<short, 1> &accumulators_buf,
+                                     buffer<short, 1> &partial_buf);
+
+// accumulators[(rho+rhos)*thetas + theta] for every pixel != 0, laid out like the fixed-size RunKernel
+void RunKernel(const HoughSize &size, const char pixels[], short accumulators[],
+               HoughKernel kernel = HoughKernel::automatic);
@@ -0,0 +1,162 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "image_loader.hpp"
+
+template <typename T>
+static T ReadLE(const uint8_t *p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T)); // BMP headers are little-endian like the host
+    return value;
+}
+
+// Next whitespace separated token of a PGM header, '#' comments run to the end of the line.
+// Values stop growing once they exceed UINT_MAX, so an absurd number cannot wrap around
+static size_t PgmToken(const uint8_t *p, size_t size, size_t &pos)
+{
+    while (pos < size && (isspace(p[pos]) || p[pos] == '#')) {
+      if (p[pos] == '#') while (pos < size && p[pos] != '\n') pos++;
+      else pos++;
+    }
+    size_t value = 0;
+    while (pos < size && isdigit(p[pos])) {
+      if (value <= UINT_MAX) value = value * 10 + (p[pos] - '0');
+      pos++;
+    }
+    return value;
+}
+
+MappedImage::MappedImage(const std::string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("cannot open " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 2) {
+      close(fd);
+      throw std::runtime_error("cannot read " + path);
+    }
+    map_size_ = st.st_size;
+    void *map = mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) throw std::runtime_error("cannot map " + path);
+    map_ = static_cast<const uint8_t *>(map);
+    madvise(map, map_size_, MADV_SEQUENTIAL);
+
+    size_t offset = 0; // of the first pixel row
+
+    if (map_[0] == 'B' && map_[1] == 'M' && map_size_ >= 54) {
+      //Bitmap: 14-byte file header followed by a BITMAPINFOHEADER
+      offset = ReadLE<uint32_t>(map_ + 10);
+      int32_t w = ReadLE<int32_t>(map_ + 18);
+      int32_t h = ReadLE<int32_t>(map_ + 22);
+      uint16_t bits = ReadLE<uint16_t>(map_ + 28);
+      uint32_t compression = ReadLE<uint32_t>(map_ + 30);
+      if ((bits != 24 && bits != 32) || (compression != 0 && compression != 3) || w <= 0 || h == 0 || h == INT32_MIN) {
+        Fail(path + ": only uncompressed 24/32-bit bitmaps are supported");
+      }
+      width_ = w;
+      height_ = std::abs(h);
+      bottom_up_ = h > 0; // positive height: rows are stored bottom to top
+      channels_ = bits / 8;
+      stride_ = ((size_t)width_ * channels_ + 3) & ~(size_t)3; // rows are padded to 4 bytes
+    } else if (map_[0] == 'P' && map_[1] == '5') {
+      //Binary graymap: "P5 <width> <height> <maxval>" and one whitespace byte before the pixels
+      size_t pos = 2;
+      size_t w = PgmToken(map_, map_size_, pos);
+      size_t h = PgmToken(map_, map_size_, pos);
+      size_t maxval = PgmToken(map_, map_size_, pos);
+      if (maxval == 0 || maxval > 255 || w == 0 || h == 0 || w > UINT_MAX || h > UINT_MAX) {
+        Fail(path + ": only 8-bit binary PGM files are supported");
+      }
+      width_ = w;
+      height_ = h;
+      channels_ = 1;
+      stride_ = width_;
+      offset = pos + 1;
+    } else {
+      Fail(path + ": not a BMP or binary PGM file");
+    }
+
+    // Divide instead of multiplying, so neither the size nor a pointer can wrap around
+    if (offset > map_size_ || (map_size_ - offset) / stride_ < height_) {
+      Fail(path + ": file is truncated");
+    }
+    data_ = map_ + offset;
+}
+
+MappedImage::~MappedImage()
+{
+    munmap(const_cast<uint8_t *>(map_), map_size_);
+}
+
+void MappedImage::Fail(const std::string &message)
+{
+    munmap(const_cast<uint8_t *>(map_), map_size_);
+    throw std::runtime_error(message);
+}
+
+const uint8_t *MappedImage::Row(unsigned int y) const
+{
+    return data_ + (bottom_up_ ? height_ - 1 - y : y) * stride_;
+}
+
+// Branch-free loops over contiguous bytes, so the compiler can vectorize them
+void MappedImage::Binarize(char pixels[]) const
+{
+    for (unsigned int y = 0; y < height_; y++) {
+      const uint8_t *src = Row(y);
+      char *dst = pixels + (size_t)y * width_;
+      if (channels_ == 1) {
+        for (unsigned int x = 0; x < width_; x++) dst[x] = src[x] != 0;
+      } else if (channels_ == 3) {
+        for (unsigned int x = 0; x < width_; x++) dst[x] = (src[3*x] | src[3*x+1] | src[3*x+2]) != 0;
+      } else {
+        for (unsigned int x = 0; x < width_; x++) dst[x] = (src[4*x] | src[4*x+1] | src[4*x+2]) != 0;
+      }
+    }
+}
+
+// Integer BT.601 weights (77, 150, 29) / 256
+void MappedImage::Luminance(uint8_t gray[]) const
+{
+    for (unsigned int y = 0; y < height_; y++) {
+      const uint8_t *src = Row(y);
+      uint8_t *dst = gray + (size_t)y * width_;
+      if (channels_ == 1) {
+        std::memcpy(dst, src, width_);
+      } else {
+        for (unsigned int x = 0; x < width_; x++) {
+          const uint8_t *p = src + (size_t)channels_ * x;
+          dst[x] = (29*p[0] + 150*p[1] + 77*p[2]) >> 8; // stored as b, g, r
+        }
+      }
+    }
+}
+
+void MappedImage::BinarizeRaw(char pixels[], size_t count) const
+{
+    if (data_ + count * channels_ > map_ + map_size_) {
+      throw std::out_of_range("raw pixel count exceeds the file size");
+    }
+    const uint8_t *src = data_;
+    if (channels_ == 1) {
+      for (size_t i = 0; i < count; i++) pixels[i] = src[i] != 0;
+    } else if (channels_ == 3) {
+      for (size_t i = 0; i < count; i++) pixels[i] = (src[3*i] | src[3*i+1] | src[3*i+2]) != 0;
+    } else {
+      for (size_t i = 0; i < count; i++) pixels[i] = (src[4*i] | src[4*i+1] | src[4*i+2]) != 0;
+    }
+}
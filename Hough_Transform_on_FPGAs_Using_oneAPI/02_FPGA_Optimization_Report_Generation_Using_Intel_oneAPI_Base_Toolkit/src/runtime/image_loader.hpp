@@ -0,0 +1,49 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Memory-mapped edge image, 24/32-bit uncompressed BMP or 8-bit binary PGM (P5).
+// The header is parsed for dimensions, row padding and orientation. Pixels are
+// binarized straight from the mapping into the caller's buffer (for example the
+// pixel vector of a HoughFrame), so there is no intermediate pixel array.
+class MappedImage {
+public:
+  // Throws std::runtime_error if the file cannot be mapped or the format is not supported
+  explicit MappedImage(const std::string &path);
+  ~MappedImage();
+  MappedImage(const MappedImage &) = delete;
+  MappedImage &operator=(const MappedImage &) = delete;
+
+  unsigned int width() const { return width_; }
+  unsigned int height() const { return height_; }
+
+  // pixels[y*width + x] = 1 for a non-black pixel, 0 otherwise, row 0 is the top of the image
+  void Binarize(char pixels[]) const;
+
+  // gray[y*width + x] = 8-bit luminance, row 0 is the top of the image
+  void Luminance(uint8_t gray[]) const;
+
+  // The first count pixels in file storage order, ignoring rows and padding.
+  // This is how the fixed-size read_image reads Assets/pic.bmp for the golden check.
+  void BinarizeRaw(char pixels[], size_t count) const;
+
+private:
+  [[noreturn]] void Fail(const std::string &message); // unmap and throw from the constructor
+  const uint8_t *Row(unsigned int y) const;
+
+  const uint8_t *map_ = nullptr;
+  size_t map_size_ = 0;
+  const uint8_t *data_ = nullptr; // first pixel in storage order
+  unsigned int width_ = 0, height_ = 0;
+  unsigned int channels_ = 0;     // bytes per pixel
+  size_t stride_ = 0;             // bytes per row including padding
+  bool bottom_up_ = false;
+};
@@ -0,0 +1,68 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <vector>
+#include <CL/sycl.hpp>
+#include <cstdlib>
+#include "hough_incremental.hpp"
+
+using namespace std;
+
+// Usage: hough_transform_incremental [width height [changes [frames]]]
+// A random sparse edge frame is voted once, then every following frame toggles
+// `changes` random pixels and is applied incrementally. The persistent
+// accumulator is compared with a full RunKernel of the final frame.
+
+int main(int argc, char *argv[]) {
+  uint width = (argc > 2) ? atoi(argv[1]) : 640;
+  uint height = (argc > 2) ? atoi(argv[2]) : 480;
+  uint changes = (argc > 3) ? atoi(argv[3]) : 100;
+  int frames = (argc > 4) ? atoi(argv[4]) : 10;
+  if (frames <= 0) {
+    cout << "Usage: " << argv[0] << " [width height [changes [frames]]], frames must be positive" << std::endl;
+    return 1;
+  }
+
+  HoughSize size = MakeHoughSize(width, height, 180);
+  cout << "Image: " << width << "x" << height << ", changed pixels per frame: " << changes << std::endl;
+
+  srand(1);
+  vector<char> pixels(size.image_size());
+  for (auto &p : pixels) p = (rand() % 20) == 0;
+
+  HoughIncremental hough(size);
+  hough.Reset(pixels.data());
+
+  vector<uint32_t> added, removed;
+  double total = 0;
+  for (int f = 0; f < frames; f++) {
+    vector<char> next(pixels);
+    for (uint c = 0; c < changes; c++) {
+      size_t i = (size_t)rand() % next.size();
+      next[i] = !next[i];
+    }
+    DiffEdges(size, pixels.data(), next.data(), added, removed);
+    total += hough.Update(added, removed);
+    pixels.swap(next);
+  }
+  cout << "Incremental update time: " << total / frames << " seconds per frame" << std::endl;
+
+  // Reference: vote the final frame from scratch
+  vector<short> expected(size.accumulator_size()), actual(size.accumulator_size());
+  RunKernel(size, pixels.data(), expected.data());
+  hough.Read(actual.data());
+
+  vector<HoughLine> lines = hough.Lines(4, 1);
+  for (auto &line : lines) {
+    cout << "Line: rho " << line.rho << ", theta " << line.theta << ", votes " << line.votes << std::endl;
+  }
+
+  bool failed = (expected != actual);
+  if (failed) {printf("FAILED\n");}
+  else {printf("VERIFICATION PASSED!!\n");}
+
+  return failed;
+}
@@ -0,0 +1,97 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <vector>
+#include <CL/sycl.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include "hough_peaks.hpp"
+#include "image_loader.hpp"
+
+using namespace std;
+
+// Usage: hough_transform_runtime [image.bmp|image.pgm [thetas [width height]]]
+// Without width/height the image dimensions and orientation are taken from the file header.
+// With width/height the first width*height pixels are read in file order, like the fixed-size
+// read_image. With no arguments that is the first 180x120 pixels of Assets/pic.bmp, and the
+// results are checked against util/golden_check_file.txt
+
+int main(int argc, char *argv[]) {
+  const char *path = (argc > 1) ? argv[1] : "Assets/pic.bmp";
+  uint thetas = (argc > 2) ? atoi(argv[2]) : 180;
+  uint width = (argc > 4) ? atoi(argv[3]) : (argc > 1) ? 0 : 180;
+  uint height = (argc > 4) ? atoi(argv[4]) : (argc > 1) ? 0 : 120;
+
+  //Memory-mapped loader, pixels are binarized straight from the file mapping
+  vector<char> pixels;
+  try {
+    MappedImage image(path);
+    if (width == 0) {
+      width = image.width();
+      height = image.height();
+      pixels.resize((size_t)width*height);
+      image.Binarize(pixels.data());
+    } else {
+      pixels.resize((size_t)width*height);
+      image.BinarizeRaw(pixels.data(), pixels.size());
+    }
+  } catch (std::exception const &e) {
+    cout << "Could not read " << path << ": " << e.what() << std::endl;
+    return 1;
+  }
+
+  HoughSize size = MakeHoughSize(width, height, thetas);
+  cout << "Image: " << width << "x" << height << ", thetas: " << thetas << ", rhos: " << size.rhos << std::endl;
+
+  // Heap allocated, a 1920x1080 frame no longer fits the fixed-size stack arrays
+  vector<short> accumulators(size.accumulator_size(), 0);
+
+  RunKernel(size, pixels.data(), accumulators.data());
+
+  // Peak detection on the device, only the strongest lines are copied back
+  vector<HoughLine> lines = FindHoughLines(size, pixels.data(), 8, 10);
+  for (auto &line : lines) {
+    cout << "Line: rho " << line.rho << ", theta " << line.theta << ", votes " << line.votes << std::endl;
+  }
+
+  // The strongest line must be the global maximum of the full accumulator
+  short max_votes = *max_element(accumulators.begin(), accumulators.end());
+  bool peaks_failed = lines.empty() || lines[0].votes != (uint)max_votes;
+  if (peaks_failed) {printf("PEAK DETECTION FAILED\n");}
+
+  if (width != 180 || height != 120 || thetas != 180) {
+    return peaks_failed;
+  }
+
+  ifstream myFile;
+  myFile.open("util/golden_check_file.txt",ifstream::in);
+  ofstream checkFile;
+  checkFile.open("util/compare_results.txt",ofstream::out);
+
+  vector<int> myList;
+  int number;
+  while (myFile >> number) {
+    myList.push_back(number);
+  }
+
+  bool failed = myList.size() < accumulators.size();
+  for (size_t i=0; i<accumulators.size() && i<myList.size(); i++) {
+    if ((myList[i]>accumulators[i]+1) || (myList[i]<accumulators[i]-1)) { //Test the results against the golden results
+      failed = true;
+      checkFile << "Failed at " << i << ". Expected: " << myList[i] << ", Actual: "
+	      << accumulators[i] << std::endl;
+    }
+  }
+
+  myFile.close();
+  checkFile.close();
+
+  if (failed) {printf("FAILED\n");}
+  else {printf("VERIFICATION PASSED!!\n");}
+
+  return failed || peaks_failed;
+}
@@ -0,0 +1,61 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <vector>
+#include <CL/sycl.hpp>
+#include <cstdlib>
+#include "hough_sobel.hpp"
+#include "image_loader.hpp"
+
+using namespace std;
+
+// Usage: hough_transform_sobel image.bmp|image.pgm [thetas [edge_threshold [k]]]
+// A raw (not yet edge-detected) frame is uploaded once; Sobel, voting and peak
+// detection run on the device and only the k strongest lines come back.
+// The lines are checked against a host Sobel pass followed by FindHoughLines.
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    cout << "Usage: " << argv[0] << " image.bmp|image.pgm [thetas [edge_threshold [k]]]" << std::endl;
+    return 1;
+  }
+  uint thetas = (argc > 2) ? atoi(argv[2]) : 180;
+  uint edge_threshold = (argc > 3) ? atoi(argv[3]) : 128;
+  uint k = (argc > 4) ? atoi(argv[4]) : 8;
+
+  vector<uint8_t> gray;
+  HoughSize size;
+  try {
+    MappedImage image(argv[1]);
+    size = MakeHoughSize(image.width(), image.height(), thetas);
+    gray.resize(size.image_size());
+    image.Luminance(gray.data());
+  } catch (std::exception const &e) {
+    cout << "Could not read " << argv[1] << ": " << e.what() << std::endl;
+    return 1;
+  }
+  cout << "Image: " << size.width << "x" << size.height << ", thetas: " << thetas << std::endl;
+
+  vector<HoughLine> lines = DetectLines(size, gray.data(), edge_threshold, k, 10);
+  for (auto &line : lines) {
+    cout << "Line: rho " << line.rho << ", theta " << line.theta << ", votes " << line.votes << std::endl;
+  }
+
+  // Reference: host Sobel, then the edge-map pipeline
+  vector<char> edges(size.image_size());
+  SobelReference(size, gray.data(), edge_threshold, edges.data());
+  vector<HoughLine> expected = FindHoughLines(size, edges.data(), k, 10);
+
+  bool failed = lines.size() != expected.size();
+  for (size_t i = 0; i < lines.size() && !failed; i++) {
+    failed = lines[i].rho != expected[i].rho || lines[i].theta != expected[i].theta || lines[i].votes != expected[i].votes;
+  }
+
+  if (failed) {printf("FAILED\n");}
+  else {printf("VERIFICATION PASSED!!\n");}
+
+  return failed;
+}
@@ -0,0 +1,93 @@
+//==============================================================
+// Copyright © 2020 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include "hough_stream.hpp"
+
+using namespace std;
+
+// Usage: hough_transform_stream [frames [width height [thetas [peaks]]]]
+// Synthetic edge-detected video: every frame holds one horizontal edge that moves
+// down by one row per frame plus sparse noise. The strongest line of each frame
+// must be theta 90 at rho equal to the edge row. With peaks > 0 (default 4) only
+// the strongest lines leave the device, with peaks = 0 the full accumulator does.
+
+static void make_frame(vector<char> &pixels, uint width, uint height, int frame) {
+  uint row = frame % height;
+  for (uint y = 0; y < height; y++) {
+    for (uint x = 0; x < width; x++) {
+      pixels[(size_t)y*width+x] = (y == row) || ((x*7 + y*13 + frame) % 997 == 0);
+    }
+  }
+}
+
+static bool check_frame(const HoughFrame &result, const HoughSize &size, int frame) {
+  if (!result.lines.empty()) {
+    return result.lines[0].theta == size.thetas / 2 && result.lines[0].rho == (int)(frame % size.height);
+  }
+  auto &accumulators = result.accumulators;
+  auto peak = max_element(accumulators.begin(), accumulators.end()) - accumulators.begin();
+  int rho = (int)(peak / size.thetas) - (int)size.rhos;
+  uint theta = peak % size.thetas;
+  return theta == size.thetas / 2 && rho == (int)(frame % size.height);
+}
+
+static double percentile(vector<double> values, double p) {
+  sort(values.begin(), values.end());
+  return values[(size_t)(p * (values.size() - 1))];
+}
+
+int main(int argc, char *argv[]) {
+  int frames = (argc > 1) ? atoi(argv[1]) : 100;
+  uint width = (argc > 3) ? atoi(argv[2]) : 640;
+  uint height = (argc > 3) ? atoi(argv[3]) : 480;
+  uint thetas = (argc > 4) ? atoi(argv[4]) : 180;
+  uint peaks = (argc > 5) ? atoi(argv[5]) : 4;
+  if (frames <= 0) {
+    cout << "Usage: " << argv[0] << " [frames [width height [thetas [peaks]]]], frames must be positive" << std::endl;
+    return 1;
+  }
+
+  HoughSize size = MakeHoughSize(width, height, thetas);
+  cout << "Frames: " << frames << ", image: " << width << "x" << height << ", thetas: " << thetas << std::endl;
+
+  HoughStream stream(size, peaks);
+
+  // warm up, includes kernel JIT compilation
+  auto &warm = stream.Acquire(0);
+  make_frame(warm.pixels, width, height, 0);
+  stream.Submit(warm);
+  stream.Finish();
+
+  int failed = 0;
+  size_t warm_frames = stream.Latencies().size();
+  auto start = chrono::high_resolution_clock::now();
+  for (int f = 0; f < frames; f++) {
+    // the slot was last used two frames ago, its results are checked before it is refilled
+    auto &frame = stream.Acquire(f);
+    if (f >= 2 && !check_frame(frame, size, f - 2)) failed++;
+    make_frame(frame.pixels, width, height, f);
+    stream.Submit(frame);
+  }
+  stream.Finish();
+  double seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+
+  for (int f = max(frames - 2, 0); f < frames; f++) {
+    if (!check_frame(stream.Acquire(f), size, f)) failed++;
+  }
+
+  vector<double> latencies(stream.Latencies().begin() + warm_frames, stream.Latencies().end());
+  cout << "Throughput: " << frames / seconds << " frames/second" << std::endl;
+  cout << "Latency p50: " << percentile(latencies, 0.50) * 1000 << " ms, p90: " << percentile(latencies, 0.90) * 1000
+       << " ms, p99: " << percentile(latencies, 0.99) * 1000 << " ms" << std::endl;
+
+  if (failed) {printf("FAILED (%d frames)\n", failed);}
+  else {printf("VERIFICATION PASSED!!\n");}
+
+  return failed != 0;
+}
@@ -0,0 +1,7 @@
+#!/bin/bash
+source /opt/intel/oneapi/setvars.sh > /dev/null 2>&1
+/bin/echo "##" $(whoami) is compiling oneMKL_introduction Module0 -- batched gemm pipeline with usm dpcpp_gemm_batch_usm.cpp
+
+icpx -fsycl  -fsycl-device-code-split=per_kernel -DMKL_ILP64 -I$MKLROOT/include -L$MKLROOT/lib/intel64 -lmkl_sycl -lmkl_intel_ilp64 -lmkl_sequential -lmkl_core -lsycl -lOpenCL -lpthread -lm -ldl src/dpcpp_gemm_batch_usm.cpp
+
+if [ $? -eq 0 ]; then ./a.out; fi
@@ -0,0 +1,146 @@
+//==============================================================
+// Copyright © 2023 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <sycl/sycl.hpp>          //# sycl namespace
+#include "oneapi/mkl/blas.hpp"  //# oneMKL DPC++ interface for BLAS functions
+
+// # The following project performs many small matrix multiplications using oneMKL gemm_batch with Unified Shared Memory (USM)
+// # Each batch executes C = A * B followed by the dependent D = C * B
+// # The two gemm_batch calls and the copies are chained through sycl events, the host never waits on them directly
+// # Two pipeline slots are used so the host prepares the next batch while the device works on the current one
+// # The matrix B is set equal to the identity matrix such that D = A * I * I -> A = D
+
+using namespace sycl;
+namespace mkl = oneapi::mkl;  //# shorten mkl namespace
+
+//# one stage of the double buffered pipeline
+struct gemm_slot {
+    float *A_host, *B_host, *D_host;         //# pinned host staging memory
+    float *A_dev, *B_dev, *C_dev, *D_dev;    //# device memory
+    sycl::event done;                        //# last operation that touches this slot
+};
+
+class gemm_batch_pipeline {
+public:
+    gemm_batch_pipeline(queue &q, std::int64_t m, std::int64_t max_batch) : q(q), m(m), max_batch(max_batch) {
+        size_t count = m * m * max_batch;
+        for (auto &s : slots) {
+            s.A_host = malloc_host<float>(count, q);
+            s.B_host = malloc_host<float>(count, q);
+            s.D_host = malloc_host<float>(count, q);
+            s.A_dev = malloc_device<float>(count, q);
+            s.B_dev = malloc_device<float>(count, q);
+            s.C_dev = malloc_device<float>(count, q);
+            s.D_dev = malloc_device<float>(count, q);
+        }
+    }
+
+    ~gemm_batch_pipeline() {
+        for (auto &s : slots) {
+            s.done.wait();
+            for (float *p : {s.A_host, s.B_host, s.D_host, s.A_dev, s.B_dev, s.C_dev, s.D_dev}) free(p, q);
+        }
+    }
+
+    //# wait until slot i is free again, after this its host memory may be read and refilled
+    gemm_slot &acquire(int i) {
+        slots[i % 2].done.wait();
+        return slots[i % 2];
+    }
+
+    //# upload, C = A * B, D = C * B, download; every step depends only on the previous event
+    void submit(gemm_slot &s, std::int64_t batch) {
+        std::int64_t stride = m * m;
+        size_t bytes = sizeof(float) * stride * batch;
+        float alpha = 1.0, beta = 0.0;
+        mkl::transpose trans = mkl::transpose::nontrans;
+
+        auto upload_A = q.memcpy(s.A_dev, s.A_host, bytes);
+        auto upload_B = q.memcpy(s.B_dev, s.B_host, bytes);
+        auto gemm_C = mkl::blas::gemm_batch(q, trans, trans, m, m, m, alpha, s.A_dev, m, stride, s.B_dev, m, stride, beta, s.C_dev, m, stride, batch, {upload_A, upload_B});
+        auto gemm_D = mkl::blas::gemm_batch(q, trans, trans, m, m, m, alpha, s.C_dev, m, stride, s.B_dev, m, stride, beta, s.D_dev, m, stride, batch, {gemm_C});
+        s.done = q.memcpy(s.D_host, s.D_dev, bytes, gemm_D);
+    }
+
+    void finish() {
+        for (auto &s : slots) s.done.wait();
+    }
+
+private:
+    queue &q;
+    std::int64_t m, max_batch;
+    gemm_slot slots[2];
+};
+
+//# host side preparation of one batch
+void prepare(gemm_slot &s, std::int64_t m, std::int64_t batch, int round) {
+    for (std::int64_t b = 0; b < batch; b++) {
+        for (std::int64_t i = 0; i < m; i++) {
+            for (std::int64_t j = 0; j < m; j++) {
+                s.A_host[(b*m+i)*m+j] = (float)((round + b + i*m+j) % 97) + 1.0;
+                s.B_host[(b*m+i)*m+j] = (i == j) ? 1.0 : 0.0;
+            }
+        }
+    }
+}
+
+//# verify D = A for a completed batch
+int verify(gemm_slot &s, std::int64_t m, std::int64_t batch) {
+    for (std::int64_t idx = 0; idx < m * m * batch; idx++)
+        if (s.A_host[idx] != s.D_host[idx]) return 1;
+    return 0;
+}
+
+int main() {
+
+    //# dimensions of every small square matrix
+    std::int64_t m = 8;
+
+    //# number of batches pushed through the pipeline per batch size
+    int rounds = 20;
+
+    std::vector<std::int64_t> batch_sizes = {1, 10, 100, 1000, 10000};
+
+    queue q;
+    device my_device = q.get_device();
+    std::cout << "Device: " << my_device.get_info<info::device::name>() << "\n";
+    std::cout << "Matrix: " << m << "x" << m << ", 2 dependent gemm_batch calls per batch\n\n";
+
+    gemm_batch_pipeline pipeline(q, m, batch_sizes.back());
+
+    int status = 0;
+    for (auto batch : batch_sizes) {
+        //# warm up, includes kernel JIT compilation
+        auto &warm = pipeline.acquire(0);
+        prepare(warm, m, batch, 0);
+        pipeline.submit(warm, batch);
+        pipeline.finish();
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            //# the slot was last used two rounds ago, its results are checked before it is refilled
+            auto &s = pipeline.acquire(r);
+            if (r >= 2) status |= verify(s, m, batch);
+            prepare(s, m, batch, r);
+            pipeline.submit(s, batch);
+        }
+        pipeline.finish();
+        double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        for (int r = rounds - 2; r < rounds; r++) {
+            if (r >= 0) status |= verify(pipeline.acquire(r), m, batch);
+        }
+
+        double matrices = 2.0 * batch * rounds;
+        double gflops = matrices * 2.0 * m * m * m / seconds / 1e9;
+        std::cout << "batch " << batch << " : " << seconds << " s, " << matrices / seconds << " gemm/s, " << gflops << " GFLOPS\n";
+    }
+
+    status == 0 ? std::cout << "\nVerified: A = D\n" : std::cout << "\nFailed: A != D\n";
+    return status;
+}
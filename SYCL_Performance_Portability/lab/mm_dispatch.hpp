@@ -0,0 +1,46 @@
+//==============================================================
+// Matrix Multiplication: GEMM Dispatch Layer
+//==============================================================
+// Copyright © 2021 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#pragma once
+
+#include <CL/sycl.hpp>
+#include <string>
+
+using namespace sycl;
+
+//# Implementation in mm_dispatch.cpp
+//# Every backend shares one call signature: row-major C = A * B on host memory,
+//# A is m x k, B is k x n, C is m x n, for T = float or double.
+//#
+//# Backends compiled in:
+//#   sycl_tiled : shared local memory tiled SYCL kernel, always available
+//#   onemkl     : oneapi::mkl::blas::gemm, needs -DMM_DISPATCH_ONEMKL and oneMKL link flags
+//#   omp_mkl    : sgemm/dgemm under omp target variant dispatch, needs -DMM_DISPATCH_OMP and -fiopenmp -fopenmp-targets=spir64
+//#                only used when an OpenMP device matches the queue's device
+
+enum class mm_backend { sycl_tiled, onemkl, omp_mkl };
+
+template <typename T>
+using mm_gemm_fn = void (*)(queue &q, const T *A, const T *B, T *C, size_t m, size_t n, size_t k);
+
+const char *mm_backend_name(mm_backend backend);
+
+//# calibration results are cached in this file, default "mm_dispatch.cache" in the working directory
+void mm_dispatch_cache_file(const std::string &path);
+
+//# fastest backend for (shape, dtype, device); on a cache miss all backends are timed once and the winner is stored
+template <typename T>
+mm_backend mm_dispatch_select(queue &q, size_t m, size_t n, size_t k);
+
+//# C = A * B using the selected backend
+template <typename T>
+void mm_gemm(queue &q, const T *A, const T *B, T *C, size_t m, size_t n, size_t k);
+
+//# C = A * B using an explicit backend, an unavailable backend prints a warning and recalibrates
+template <typename T>
+void mm_gemm(mm_backend backend, queue &q, const T *A, const T *B, T *C, size_t m, size_t n, size_t k);
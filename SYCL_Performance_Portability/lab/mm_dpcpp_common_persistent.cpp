@@ -0,0 +1,143 @@
+//==============================================================
+// Matrix Multiplication: SYCL Matrix Multiplication Common Persistent
+//==============================================================
+// Copyright © 2021 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+
+#include <CL/sycl.hpp>
+#include <getopt.h>
+#include <ctime>
+#include <chrono>
+#include "mm_dpcpp_usm.hpp"
+
+using namespace sycl;
+
+//# floating point error verification function
+bool almost_equal(float a, float b){
+    float tolerance = 1e-6;
+    float diff = fabs(a - b);
+    a = fabs(a);
+    b = fabs(b);
+    float bigger = (b > a) ? b : a;
+    if(diff <= bigger * tolerance) return true;
+    return false;
+}
+
+int main(int argc, char *argv[]) {
+
+    size_t N = 1024;
+    size_t M = 16;
+    int ITERATIONS = 10;
+    int VERIFY = 0;
+    int PRINT_OUTPUT_MATRIX = 0;
+
+    //# command line arguments
+    int arg;
+    while ((arg = getopt (argc, argv, "n:m:i:vph")) != -1)
+        switch (arg){
+            case 'n':
+                N = std::atoi(optarg);
+                break;
+            case 'm':
+                M = std::atoi(optarg);
+                break;
+            case 'i':
+                ITERATIONS = std::atoi(optarg);
+                break;
+            case 'v':
+                VERIFY = 1;
+                break;
+            case 'p':
+                PRINT_OUTPUT_MATRIX = 1;
+                break;
+            case 'h':
+                std::cout << std::endl;
+                std::cout << "Usage   : ./a.out -n <MATRIX_SIZE> -m <WORK_GROUP_SIZE> -i <ITERATIONS> -v -p\n\n";
+                std::cout << "          [-n] size for matrix, eg: 1024\n";
+                std::cout << "          [-m] size of work_group, eg: 8/16\n";
+                std::cout << "          [-i] number of chained multiplications X = X * B, eg: 10\n";
+                std::cout << "          [-v] verify output with linear computation on cpu\n";
+                std::cout << "          [-p] print output matrix\n";
+                std::cout << "Example : ./a.out -n 1024 -m 16 -i 10 -v -p\n\n";
+                std::exit(0);
+        }
+
+    //# Define vectors for matrices
+    std::vector<float> matrix_a(N*N);
+    std::vector<float> matrix_b(N*N);
+    std::vector<float> matrix_c(N*N);
+
+    //# Initialize matrices with values
+    //# B is the identity matrix so the chained result stays bounded and must equal A
+    float v1 = 2.f;
+    for (int i=0; i<N; i++)
+        for (int j=0; j<N; j++){
+            matrix_a[i*N+j] = v1++;
+            matrix_b[i*N+j] = (i == j) ? 1.f : 0.f;
+            matrix_c[i*N+j] = 0.f;
+    }
+
+    //# Define queue with default device for offloading computation
+    queue q(property::queue::enable_profiling{});
+    std::cout << "Offload Device        : " << q.get_device().get_info<info::device::name>() << "\n";
+    std::cout << "max_work_group_size   : " << q.get_device().get_info<info::device::max_work_group_size>() << "\n";
+    std::cout << "Configuration         : MATRIX_SIZE= " << N << "x" << N << " | WORK_GROUP_SIZE= " << M << "x" << M << " | ITERATIONS= " << ITERATIONS << "\n";
+
+    //# Upload operands once, they stay resident on the device
+    auto start = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    float *X = mm_upload(q, matrix_a, N);
+    float *B = mm_upload(q, matrix_b, N);
+    float *work = malloc_device<float>(N*N, q);
+    auto upload_duration = std::chrono::high_resolution_clock::now().time_since_epoch().count() - start;
+    std::cout << "Upload Duration       : " << upload_duration / 1e+9 << " seconds\n";
+
+    //# Submit the whole chain, then wait once
+    start = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    auto e = mm_chain(q, X, work, B, N, M, ITERATIONS);
+    e.wait();
+    auto compute_duration = std::chrono::high_resolution_clock::now().time_since_epoch().count() - start;
+    double gflops = 2.0 * N * N * N * ITERATIONS / compute_duration;
+    std::cout << "Compute Duration      : " << compute_duration / 1e+9 << " seconds\n";
+    std::cout << "Compute Throughput    : " << gflops << " GFLOPS\n";
+
+    //# Download result only when needed
+    start = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    mm_download(q, X, matrix_c, N);
+    auto download_duration = std::chrono::high_resolution_clock::now().time_since_epoch().count() - start;
+    std::cout << "Download Duration     : " << download_duration / 1e+9 << " seconds\n";
+
+    free(X, q);
+    free(B, q);
+    free(work, q);
+
+    //# Print Output if -p in cmd-line
+    if (PRINT_OUTPUT_MATRIX){
+        for (int i=0; i<N; i++){
+            for (int j=0; j<N; j++){
+                std::cout << matrix_c[i*N+j] << " ";
+            }
+            std::cout << "\n";
+        }
+    } else {
+        std::cout << " [0][0] = " << matrix_c[0] << "\n";
+    }
+
+    //# Compare with A if -v in cmd-line, since A * I * ... * I = A
+    if (VERIFY){
+        int fail = 0;
+        for(int i=0; i<N; i++){
+            for (int j = 0; j < N; j++) {
+                if(!almost_equal(matrix_c[i*N+j], matrix_a[i*N+j])) fail = 1;
+            }
+        }
+        if(fail == 1){
+            std::cout << "FAIL\n";
+        } else {
+            std::cout << "PASS\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,14 @@
+#!/bin/bash
+source /opt/intel/inteloneapi/setvars.sh > /dev/null 2>&1
+
+#Command Line Arguments
+arg=" -n 1024" # set matrix size
+src="lab/"
+
+#calibration results are cached here, delete the file to re-calibrate
+#rm -f mm_dispatch.cache
+
+echo ====================
+echo mm_dpcpp_dispatch
+icpx -fsycl -fiopenmp -fopenmp-targets=spir64 ${src}mm_dpcpp_dispatch.cpp ${src}mm_dispatch.cpp ${src}mm_dpcpp_common.cpp -DMM_DISPATCH_ONEMKL -DMM_DISPATCH_OMP -DMKL_ILP64 -I$MKLROOT/include -L$MKLROOT/lib/intel64 -lmkl_sycl -Wl,--start-group -lmkl_intel_ilp64 -lmkl_sequential -lmkl_core -Wl,--end-group -lsycl -lOpenCL -lpthread -lm -ldl -O3 -o ${src}mm_dpcpp_dispatch
+./${src}mm_dpcpp_dispatch$arg
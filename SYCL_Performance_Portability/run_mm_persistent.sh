@@ -0,0 +1,11 @@
+#!/bin/bash
+source /opt/intel/inteloneapi/setvars.sh > /dev/null 2>&1
+
+#Command Line Arguments
+arg=" -n 1024 -m 16 -i 10" # set matrix size, work-group size, chained multiplications
+src="lab/"
+
+echo ====================
+echo mm_dpcpp_persistent
+dpcpp ${src}mm_dpcpp_persistent.cpp ${src}mm_dpcpp_common_persistent.cpp -o ${src}mm_dpcpp_persistent -w -O3
+./${src}mm_dpcpp_persistent$arg
@@ -0,0 +1,13 @@
+#!/bin/bash
+source /opt/intel/inteloneapi/setvars.sh > /dev/null 2>&1
+
+#Command Line Arguments
+arg=" -n 4096 -m 16" # set matrix size
+threshold="1024" # matrices larger than this are split with Strassen-Winograd
+#-DSTRASSEN_VERIFY checks the result normwise against the classic kernel, -v is elementwise and does not apply
+src="lab/"
+
+echo ====================
+echo mm_dpcpp_strassen
+dpcpp ${src}mm_dpcpp_strassen.cpp ${src}mm_dpcpp_persistent.cpp ${src}mm_dpcpp_common.cpp -DSTRASSEN_THRESHOLD=${threshold} -DSTRASSEN_VERIFY -o ${src}mm_dpcpp_strassen -w -O3
+./${src}mm_dpcpp_strassen$arg
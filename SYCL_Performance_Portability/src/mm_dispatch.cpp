@@ -0,0 +1,256 @@
+//==============================================================
+// Matrix Multiplication: GEMM Dispatch Layer
+//==============================================================
+// Copyright © 2021 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+
+#include <CL/sycl.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+#include "mm_dispatch.hpp"
+
+#ifdef MM_DISPATCH_ONEMKL
+#include "oneapi/mkl/blas.hpp"  //# oneMKL DPC++ interface for BLAS functions
+#endif
+
+#ifdef MM_DISPATCH_OMP
+#include "mkl.h"              //# main mkl header
+#include "mkl_omp_offload.h"  //# mkl OMP Offload interface
+#include <omp.h>
+#endif
+
+using namespace sycl;
+
+//# Backend 1: SYCL ND-range kernel with shared local memory tiles, edges padded with zeros
+template <typename T>
+static void gemm_sycl_tiled(queue &q, const T *A, const T *B, T *C, size_t m, size_t n, size_t k) {
+    constexpr size_t TILE = 16;
+
+    //# Create buffers for matrices, destruction at the end of scope copies C back
+    buffer<T, 1> a(A, range<1>(m*k));
+    buffer<T, 1> b(B, range<1>(k*n));
+    buffer<T, 1> c(C, range<1>(m*n));
+
+    q.submit([&](handler &h){
+        auto A_acc = a.template get_access<access::mode::read>(h);
+        auto B_acc = b.template get_access<access::mode::read>(h);
+        auto C_acc = c.template get_access<access::mode::write>(h);
+
+        //# round the ND-range up to whole tiles
+        range<2> global_size((m + TILE - 1) / TILE * TILE, (n + TILE - 1) / TILE * TILE);
+        range<2> work_group_size(TILE, TILE);
+
+        accessor<T, 2, access::mode::read_write, access::target::local> A_tile(range<2>(TILE, TILE), h);
+        accessor<T, 2, access::mode::read_write, access::target::local> B_tile(range<2>(TILE, TILE), h);
+
+        h.parallel_for(nd_range<2>{global_size, work_group_size}, [=](nd_item<2> item){
+            const size_t i = item.get_global_id(0);
+            const size_t j = item.get_global_id(1);
+            const size_t x = item.get_local_id(0);
+            const size_t y = item.get_local_id(1);
+
+            T temp = 0;
+            for (size_t t = 0; t < k; t += TILE) {
+                A_tile[x][y] = (i < m && t + y < k) ? A_acc[i * k + (t + y)] : T(0);
+                B_tile[x][y] = (t + x < k && j < n) ? B_acc[(t + x) * n + j] : T(0);
+                item.barrier(access::fence_space::local_space);
+                for (size_t kk = 0; kk < TILE; kk++) {
+                    temp += A_tile[x][kk] * B_tile[kk][y];
+                }
+                item.barrier(access::fence_space::local_space);
+            }
+            if (i < m && j < n) C_acc[i * n + j] = temp;
+        });
+    });
+}
+
+#ifdef MM_DISPATCH_ONEMKL
+//# Backend 2: oneMKL, column-major so row-major C = A * B is computed as C^T = B^T * A^T
+template <typename T>
+static void gemm_onemkl(queue &q, const T *A, const T *B, T *C, size_t m, size_t n, size_t k) {
+    buffer<T, 1> a(A, range<1>(m*k));
+    buffer<T, 1> b(B, range<1>(k*n));
+    buffer<T, 1> c(C, range<1>(m*n));
+
+    T alpha = 1, beta = 0;
+    oneapi::mkl::transpose transA = oneapi::mkl::transpose::nontrans;
+    oneapi::mkl::transpose transB = oneapi::mkl::transpose::nontrans;
+    oneapi::mkl::blas::gemm(q, transA, transB, n, m, k, alpha, b, n, a, k, beta, c, n);
+}
+#endif
+
+#ifdef MM_DISPATCH_OMP
+//# OpenMP device number that runs on the same device as q, -1 if there is none.
+//# The OpenMP offload runtime numbers the GPUs of the platform in enumeration order,
+//# a CPU queue maps to the initial (host) device where MKL runs without offload.
+static int omp_device(queue &q) {
+    device d = q.get_device();
+    if (d.is_cpu()) return omp_get_initial_device();
+    if (!d.is_gpu()) return -1;
+    auto gpus = d.get_platform().get_devices(info::device_type::gpu);
+    for (size_t i = 0; i < gpus.size(); i++) {
+        if (gpus[i] == d) return i < (size_t)omp_get_num_devices() ? (int)i : -1;
+    }
+    return -1;
+}
+
+static void omp_blas_gemm(MKL_INT m, MKL_INT n, MKL_INT k, const float *A, const float *B, float *C) {
+    float alpha = 1.0, beta = 0.0;
+    sgemm("N", "N", &n, &m, &k, &alpha, B, &n, A, &k, &beta, C, &n);
+}
+
+static void omp_blas_gemm(MKL_INT m, MKL_INT n, MKL_INT k, const double *A, const double *B, double *C) {
+    double alpha = 1.0, beta = 0.0;
+    dgemm("N", "N", &n, &m, &k, &alpha, B, &n, A, &k, &beta, C, &n);
+}
+
+//# Backend 3: MKL under OpenMP offload on the OpenMP device matching q, only listed when there is one
+template <typename T>
+static void gemm_omp_mkl(queue &q, const T *A, const T *B, T *C, size_t m, size_t n, size_t k) {
+    int dnum = omp_device(q);
+    MKL_INT mm = m, nn = n, kk = k;
+    MKL_INT sizeA = m*k, sizeB = k*n, sizeC = m*n;
+
+    #pragma omp target data map(to:A[0:sizeA],B[0:sizeB]) map(from:C[0:sizeC]) device(dnum)
+    {
+        #pragma omp target variant dispatch device(dnum) use_device_ptr(A, B, C)
+        {
+            omp_blas_gemm(mm, nn, kk, A, B, C);
+        }
+    }
+}
+#endif
+
+//# backends compiled in that can run on the device of q
+template <typename T>
+static std::vector<std::pair<mm_backend, mm_gemm_fn<T>>> backends(queue &q) {
+    std::vector<std::pair<mm_backend, mm_gemm_fn<T>>> list;
+    list.push_back({mm_backend::sycl_tiled, gemm_sycl_tiled<T>});
+#ifdef MM_DISPATCH_ONEMKL
+    list.push_back({mm_backend::onemkl, gemm_onemkl<T>});
+#endif
+#ifdef MM_DISPATCH_OMP
+    if (omp_device(q) >= 0) list.push_back({mm_backend::omp_mkl, gemm_omp_mkl<T>});
+#endif
+    return list;
+}
+
+const char *mm_backend_name(mm_backend backend) {
+    switch (backend) {
+        case mm_backend::sycl_tiled: return "sycl_tiled";
+        case mm_backend::onemkl: return "onemkl";
+        case mm_backend::omp_mkl: return "omp_mkl";
+    }
+    return "unknown";
+}
+
+//# Calibration cache, one line per entry: <device>\t<dtype>\t<m>x<n>x<k>\t<backend>
+static std::string cache_path = "mm_dispatch.cache";
+static std::map<std::string, mm_backend> cache;
+static bool cache_loaded = false;
+
+void mm_dispatch_cache_file(const std::string &path) {
+    cache_path = path;
+    cache.clear();
+    cache_loaded = false;
+}
+
+static void load_cache() {
+    cache_loaded = true;
+    std::ifstream file(cache_path);
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t split = line.rfind('\t');
+        if (split == std::string::npos) continue;
+        std::string name = line.substr(split + 1);
+        for (auto b : {mm_backend::sycl_tiled, mm_backend::onemkl, mm_backend::omp_mkl})
+            if (name == mm_backend_name(b)) cache[line.substr(0, split)] = b;
+    }
+}
+
+//# shapes are bucketed to the next power of two so one calibration covers similar sizes
+static size_t bucket(size_t x) {
+    size_t b = 1;
+    while (b < x) b *= 2;
+    return b;
+}
+
+template <typename T>
+static std::string cache_key(queue &q, size_t m, size_t n, size_t k) {
+    std::ostringstream key;
+    key << q.get_device().get_info<info::device::name>() << "\t" << (sizeof(T) == 4 ? "float" : "double") << "\t"
+        << bucket(m) << "x" << bucket(n) << "x" << bucket(k);
+    return key.str();
+}
+
+template <typename T>
+mm_backend mm_dispatch_select(queue &q, size_t m, size_t n, size_t k) {
+    if (!cache_loaded) load_cache();
+    std::string key = cache_key<T>(q, m, n, k);
+    auto hit = cache.find(key);
+    if (hit != cache.end()) return hit->second;
+
+    //# one-time calibration: warm up each backend, then keep the best of a few runs
+    std::vector<T> A(m*k, T(1)), B(k*n, T(1)), C(m*n);
+    mm_backend best = mm_backend::sycl_tiled;
+    double best_time = 0;
+    for (auto &[backend, fn] : backends<T>(q)) {
+        fn(q, A.data(), B.data(), C.data(), m, n, k);
+        double time = 0;
+        for (int r = 0; r < 3; r++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            fn(q, A.data(), B.data(), C.data(), m, n, k);
+            double t = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            if (r == 0 || t < time) time = t;
+        }
+        std::cout << "Calibration           : " << mm_backend_name(backend) << " " << time << " seconds\n";
+        if (best_time == 0 || time < best_time) {
+            best = backend;
+            best_time = time;
+        }
+    }
+
+    cache[key] = best;
+    std::ofstream file(cache_path, std::ios::app);
+    file << key << "\t" << mm_backend_name(best) << "\n";
+    return best;
+}
+
+template <typename T>
+void mm_gemm(mm_backend backend, queue &q, const T *A, const T *B, T *C, size_t m, size_t n, size_t k) {
+    for (auto &[b, fn] : backends<T>(q)) {
+        if (b == backend) {
+            fn(q, A, B, C, m, n, k);
+            return;
+        }
+    }
+    //# backend not compiled in or not usable on this device, e.g. a cache written by another build:
+    //# drop the cached choice and recalibrate among the backends that are available
+    std::cerr << "Warning: backend " << mm_backend_name(backend) << " is not available for "
+              << q.get_device().get_info<info::device::name>() << ", recalibrating\n";
+    if (!cache_loaded) load_cache();
+    cache.erase(cache_key<T>(q, m, n, k));
+    mm_backend available = mm_dispatch_select<T>(q, m, n, k);
+    for (auto &[b, fn] : backends<T>(q)) {
+        if (b == available) fn(q, A, B, C, m, n, k);
+    }
+}
+
+template <typename T>
+void mm_gemm(queue &q, const T *A, const T *B, T *C, size_t m, size_t n, size_t k) {
+    mm_gemm<T>(mm_dispatch_select<T>(q, m, n, k), q, A, B, C, m, n, k);
+}
+
+template mm_backend mm_dispatch_select<float>(queue &, size_t, size_t, size_t);
+template mm_backend mm_dispatch_select<double>(queue &, size_t, size_t, size_t);
+template void mm_gemm<float>(mm_backend, queue &, const float *, const float *, float *, size_t, size_t, size_t);
+template void mm_gemm<double>(mm_backend, queue &, const double *, const double *, double *, size_t, size_t, size_t);
+template void mm_gemm<float>(queue &, const float *, const float *, float *, size_t, size_t, size_t);
+template void mm_gemm<double>(queue &, const double *, const double *, double *, size_t, size_t, size_t);
@@ -0,0 +1,27 @@
+//==============================================================
+// Matrix Multiplication: SYCL GEMM Dispatch
+//==============================================================
+// Copyright © 2021 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+
+#include <CL/sycl.hpp>
+#include <chrono>
+#include "mm_dispatch.hpp"
+
+using namespace sycl;
+
+void mm_kernel(queue &q, std::vector<float> &matrix_a, std::vector<float> &matrix_b, std::vector<float> &matrix_c, size_t N, size_t M) {
+    std::cout << "Configuration         : MATRIX_SIZE= " << N << "x" << N << "\n";
+
+    //# Pick the fastest implementation, calibrates only the first time this shape is seen on this device
+    mm_backend backend = mm_dispatch_select<float>(q, N, N, N);
+    std::cout << "Selected Backend      : " << mm_backend_name(backend) << "\n";
+
+    auto start = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    mm_gemm<float>(backend, q, matrix_a.data(), matrix_b.data(), matrix_c.data(), N, N, N);
+    auto kernel_duration = std::chrono::high_resolution_clock::now().time_since_epoch().count() - start;
+    std::cout << "Kernel Execution Time : " << kernel_duration / 1e+9 << " seconds\n";
+}
@@ -0,0 +1,74 @@
+//==============================================================
+// Matrix Multiplication: SYCL USM Persistent Device Data
+//==============================================================
+// Copyright © 2021 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+
+#include <CL/sycl.hpp>
+#include "mm_dpcpp_usm.hpp"
+
+using namespace sycl;
+
+float *mm_upload(queue &q, const std::vector<float> &matrix, size_t N) {
+    //# Explicit USM allocation, data stays on the device until freed
+    float *device_ptr = malloc_device<float>(N*N, q);
+    q.memcpy(device_ptr, matrix.data(), sizeof(float)*N*N).wait();
+    return device_ptr;
+}
+
+void mm_download(queue &q, const float *C, std::vector<float> &matrix, size_t N, const std::vector<event> &deps) {
+    q.submit([&](handler &h){
+        h.depends_on(deps);
+        h.memcpy(matrix.data(), C, sizeof(float)*N*N);
+    }).wait();
+}
+
+event mm_multiply(queue &q, const float *A, size_t lda, const float *B, size_t ldb, float *C, size_t ldc, size_t n, size_t M, const std::vector<event> &deps) {
+    return q.submit([&](handler &h){
+        h.depends_on(deps);
+
+        //# Define size for ND-Range and work-group size
+        range<2> global_size(n,n);
+        range<2> work_group_size(M,M);
+
+        //# Create local accessors
+        accessor<float, 2, access::mode::read_write, access::target::local> A_tile(range<2>(M, M), h);
+        accessor<float, 2, access::mode::read_write, access::target::local> B_tile(range<2>(M, M), h);
+
+        //# Parallel Compute Matrix Multiplication, same tiling as mm_dpcpp_localmem.cpp
+        h.parallel_for(nd_range<2>{global_size, work_group_size}, [=](nd_item<2> item){
+            const int i = item.get_global_id(0);
+            const int j = item.get_global_id(1);
+            const int x = item.get_local_id(0);
+            const int y = item.get_local_id(1);
+
+            float temp = 0.f;
+            int k;
+            for (int t = 0; t < n; t+=M) {
+                A_tile[x][y] = A[i * lda + (t + y)];
+                B_tile[x][y] = B[(t + x) * ldb + j];
+                item.barrier(access::fence_space::local_space);
+                for (k = 0; k < M; k++) {
+                    temp += A_tile[x][k] * B_tile[k][y];
+                }
+                item.barrier(access::fence_space::local_space);
+            }
+            C[i*ldc+j] = temp;
+        });
+    });
+}
+
+event mm_chain(queue &q, float *&X, float *&work, const float *B, size_t N, size_t M, int iterations, const std::vector<event> &deps) {
+    //# each multiplication only depends on the previous one, the host never waits
+    std::vector<event> last = deps;
+    event e;
+    for (int it = 0; it < iterations; it++) {
+        e = mm_multiply(q, X, N, B, N, work, N, N, M, last);
+        std::swap(X, work);
+        last = {e};
+    }
+    return e;
+}
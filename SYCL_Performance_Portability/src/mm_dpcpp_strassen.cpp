@@ -0,0 +1,175 @@
+//==============================================================
+// Matrix Multiplication: SYCL Strassen-Winograd Recursive
+//==============================================================
+// Copyright © 2021 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+//
+// Above the threshold the product is split into 2x2 blocks and computed
+// with the Strassen-Winograd variant (7 multiplications, 15 additions);
+// at the leaves the shared local memory tiled kernel mm_multiply is used.
+//
+// Error bounds: the classic kernels satisfy the componentwise bound
+//     |C - fl(C)| <= N * u * |A| * |B|
+// with u = 2^-24 for float. Strassen-Winograd only satisfies a normwise bound
+//     ||C - fl(C)|| <= [(N/N0)^log2(18) * (N0^2 + 6*N0) - 6*N] * u * ||A|| * ||B||
+// where N0 is the leaf size (Higham, Accuracy and Stability of Numerical
+// Algorithms, ch. 23). Every recursion level therefore costs roughly a factor
+// of 4.5 in worst-case error; small elements of C can lose most of their
+// relative accuracy, so the -v check of mm_dpcpp_common.cpp (relative 1e-6
+// per element) is expected to fail once recursion is active.
+//
+// Built with -DSTRASSEN_VERIFY the result is instead checked normwise against
+// the classic mm_multiply product computed on the device:
+//     ||C - C_classic||_F <= (1 + 4.5^depth) * sqrt(N) * u * ||A||_F * ||B||_F
+// i.e. the classic bound plus the Strassen bound grown by 4.5 per level, in the
+// statistical sqrt(N) form (rounding errors add up like a random walk, Higham
+// ch. 3.5); the worst-case N form is too loose to catch a wrong block formula.
+
+
+#include <CL/sycl.hpp>
+#include <chrono>
+#include <cmath>
+#include "mm_dpcpp_usm.hpp"
+
+using namespace sycl;
+
+//# matrices larger than this are split, can be set at compile time with -DSTRASSEN_THRESHOLD=<N>
+#ifndef STRASSEN_THRESHOLD
+#define STRASSEN_THRESHOLD 1024
+#endif
+
+//# Z = X + sign * Y for n x n strided views, Z may alias X
+static event mm_add(queue &q, const float *X, size_t ldx, const float *Y, size_t ldy, float *Z, size_t ldz, size_t n, float sign, event dep) {
+    return q.submit([&](handler &h){
+        h.depends_on(dep);
+        h.parallel_for(range<2>{n,n}, [=](item<2> item){
+            const int i = item.get_id(0);
+            const int j = item.get_id(1);
+            Z[i*ldz+j] = X[i*ldx+j] + sign * Y[i*ldy+j];
+        });
+    });
+}
+
+//# split only while the half size still fits whole work-groups
+static bool strassen_split(size_t n, size_t M, size_t threshold) {
+    return n > threshold && n % 2 == 0 && (n / 2) % M == 0;
+}
+
+//# number of recursion levels above the mm_multiply leaves
+static int strassen_depth(size_t n, size_t M, size_t threshold) {
+    int depth = 0;
+    for (; strassen_split(n, M, threshold); n /= 2) depth++;
+    return depth;
+}
+
+size_t mm_strassen_workspace_size(size_t n, size_t M, size_t threshold) {
+    //# every level needs S1..S4, T1..T4 and P1..P7 of half size
+    size_t size = 0;
+    while (strassen_split(n, M, threshold)) {
+        n /= 2;
+        size += 15 * n * n;
+    }
+    return size;
+}
+
+//# all work is chained on a single event, so sibling recursions can reuse the same workspace region
+static event strassen(queue &q, const float *A, size_t lda, const float *B, size_t ldb, float *C, size_t ldc, size_t n, size_t M, size_t threshold, float *ws, event e) {
+    if (!strassen_split(n, M, threshold))
+        return mm_multiply(q, A, lda, B, ldb, C, ldc, n, M, {e});
+
+    const size_t h = n / 2;
+    const size_t hh = h * h;
+    const float *A11 = A, *A12 = A + h, *A21 = A + h * lda, *A22 = A + h * lda + h;
+    const float *B11 = B, *B12 = B + h, *B21 = B + h * ldb, *B22 = B + h * ldb + h;
+    float *C11 = C, *C12 = C + h, *C21 = C + h * ldc, *C22 = C + h * ldc + h;
+
+    //# carve this level's temporaries out of the arena, deeper levels use the rest
+    float *S1 = ws, *S2 = ws + hh, *S3 = ws + 2 * hh, *S4 = ws + 3 * hh;
+    float *T1 = ws + 4 * hh, *T2 = ws + 5 * hh, *T3 = ws + 6 * hh, *T4 = ws + 7 * hh;
+    float *P1 = ws + 8 * hh, *P2 = ws + 9 * hh, *P3 = ws + 10 * hh, *P4 = ws + 11 * hh;
+    float *P5 = ws + 12 * hh, *P6 = ws + 13 * hh, *P7 = ws + 14 * hh;
+    float *next = ws + 15 * hh;
+
+    e = mm_add(q, A21, lda, A22, lda, S1, h, h, 1.f, e);
+    e = mm_add(q, S1, h, A11, lda, S2, h, h, -1.f, e);
+    e = mm_add(q, A11, lda, A21, lda, S3, h, h, -1.f, e);
+    e = mm_add(q, A12, lda, S2, h, S4, h, h, -1.f, e);
+    e = mm_add(q, B12, ldb, B11, ldb, T1, h, h, -1.f, e);
+    e = mm_add(q, B22, ldb, T1, h, T2, h, h, -1.f, e);
+    e = mm_add(q, B22, ldb, B12, ldb, T3, h, h, -1.f, e);
+    e = mm_add(q, T2, h, B21, ldb, T4, h, h, -1.f, e);
+
+    e = strassen(q, A11, lda, B11, ldb, P1, h, h, M, threshold, next, e);
+    e = strassen(q, A12, lda, B21, ldb, P2, h, h, M, threshold, next, e);
+    e = strassen(q, S4, h, B22, ldb, P3, h, h, M, threshold, next, e);
+    e = strassen(q, A22, lda, T4, h, P4, h, h, M, threshold, next, e);
+    e = strassen(q, S1, h, T1, h, P5, h, h, M, threshold, next, e);
+    e = strassen(q, S2, h, T2, h, P6, h, h, M, threshold, next, e);
+    e = strassen(q, S3, h, T3, h, P7, h, h, M, threshold, next, e);
+
+    //# U2 = P1 + P6 and U3 = U2 + P7 are accumulated in place in P6 and P7
+    e = mm_add(q, P1, h, P2, h, C11, ldc, h, 1.f, e);
+    e = mm_add(q, P6, h, P1, h, P6, h, h, 1.f, e);
+    e = mm_add(q, P6, h, P7, h, P7, h, h, 1.f, e);
+    e = mm_add(q, P6, h, P5, h, P6, h, h, 1.f, e);
+    e = mm_add(q, P6, h, P3, h, C12, ldc, h, 1.f, e);
+    e = mm_add(q, P7, h, P4, h, C21, ldc, h, -1.f, e);
+    e = mm_add(q, P7, h, P5, h, C22, ldc, h, 1.f, e);
+    return e;
+}
+
+event mm_strassen(queue &q, const float *A, const float *B, float *C, size_t N, size_t M, size_t threshold, float *workspace, const std::vector<event> &deps) {
+    //# join the caller's dependencies into the single event the recursion chains on
+    event e = q.submit([&](handler &h){
+        h.depends_on(deps);
+        h.single_task([=](){});
+    });
+    return strassen(q, A, N, B, N, C, N, N, M, threshold, workspace, e);
+}
+
+void mm_kernel(queue &q, std::vector<float> &matrix_a, std::vector<float> &matrix_b, std::vector<float> &matrix_c, size_t N, size_t M) {
+    std::cout << "Configuration         : MATRIX_SIZE= " << N << "x" << N << " | WORK_GROUP_SIZE= " << M << "x" << M << " | STRASSEN_THRESHOLD= " << STRASSEN_THRESHOLD << "\n";
+
+    //# Upload operands and allocate the recursion workspace once
+    float *A = mm_upload(q, matrix_a, N);
+    float *B = mm_upload(q, matrix_b, N);
+    float *C = malloc_device<float>(N*N, q);
+    size_t workspace_size = mm_strassen_workspace_size(N, M, STRASSEN_THRESHOLD);
+    float *workspace = workspace_size ? malloc_device<float>(workspace_size, q) : nullptr;
+    std::cout << "Strassen Workspace    : " << workspace_size * sizeof(float) / 1e+6 << " MB\n";
+
+    auto start = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    mm_strassen(q, A, B, C, N, M, STRASSEN_THRESHOLD, workspace).wait();
+    auto kernel_duration = std::chrono::high_resolution_clock::now().time_since_epoch().count() - start;
+
+    mm_download(q, C, matrix_c, N);
+
+#ifdef STRASSEN_VERIFY
+    //# reference product with the classic kernel, compared normwise on the host
+    std::vector<float> matrix_d(N*N);
+    mm_multiply(q, A, N, B, N, C, N, N, M).wait();
+    mm_download(q, C, matrix_d, N);
+
+    double diff = 0, norm_a = 0, norm_b = 0;
+    for (size_t i = 0; i < N*N; i++) {
+        diff += ((double)matrix_c[i] - matrix_d[i]) * ((double)matrix_c[i] - matrix_d[i]);
+        norm_a += (double)matrix_a[i] * matrix_a[i];
+        norm_b += (double)matrix_b[i] * matrix_b[i];
+    }
+    double error = std::sqrt(diff) / (std::sqrt(norm_a) * std::sqrt(norm_b));
+    int depth = strassen_depth(N, M, STRASSEN_THRESHOLD);
+    double bound = (1 + std::pow(4.5, depth)) * std::sqrt((double)N) * std::ldexp(1.0, -24);
+    std::cout << "Strassen Check        : depth " << depth << ", normwise error " << error << " <= " << bound << " "
+              << (error <= bound ? "PASS" : "FAIL") << "\n";
+#endif
+
+    free(A, q);
+    free(B, q);
+    free(C, q);
+    if (workspace) free(workspace, q);
+
+    //# print duration of the whole recursion, it is made of many kernels
+    std::cout << "Kernel Execution Time : " << kernel_duration / 1e+9 << " seconds\n";
+}
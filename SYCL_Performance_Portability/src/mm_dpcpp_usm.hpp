@@ -0,0 +1,41 @@
+//==============================================================
+// Matrix Multiplication: SYCL USM Device-Resident API
+//==============================================================
+// Copyright © 2021 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#pragma once
+
+#include <CL/sycl.hpp>
+#include <vector>
+
+using namespace sycl;
+
+//# Implementation in mm_dpcpp_persistent.cpp
+//# Operands are uploaded once into device USM and stay resident, so many
+//# multiplications can be submitted back to back without host synchronization.
+
+//# copy a N x N host matrix into a new device USM allocation (release with sycl::free)
+float *mm_upload(queue &q, const std::vector<float> &matrix, size_t N);
+
+//# copy a N x N device matrix back to the host once deps have completed
+void mm_download(queue &q, const float *C, std::vector<float> &matrix, size_t N, const std::vector<event> &deps = {});
+
+//# C = A * B for n x n device operands with row strides lda/ldb/ldc
+//# uses M x M shared local memory tiles, n must be a multiple of M
+event mm_multiply(queue &q, const float *A, size_t lda, const float *B, size_t ldb, float *C, size_t ldc, size_t n, size_t M, const std::vector<event> &deps = {});
+
+//# X = X * B repeated iterations times, ping-ponging between X and work
+//# on return X points at the final product; only the returned event needs to be waited on
+event mm_chain(queue &q, float *&X, float *&work, const float *B, size_t N, size_t M, int iterations, const std::vector<event> &deps = {});
+
+//# Implementation in mm_dpcpp_strassen.cpp
+//# Strassen-Winograd recursion for N x N operands while N > threshold, mm_multiply at the leaves
+
+//# number of floats the caller must allocate for the recursion workspace (0 if no split happens)
+size_t mm_strassen_workspace_size(size_t n, size_t M, size_t threshold);
+
+//# C = A * B, workspace is reused by every recursion level so nothing is allocated per call
+event mm_strassen(queue &q, const float *A, const float *B, float *C, size_t N, size_t M, size_t threshold, float *workspace, const std::vector<event> &deps = {});
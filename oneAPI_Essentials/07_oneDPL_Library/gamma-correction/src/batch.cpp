@@ -0,0 +1,91 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <oneapi/dpl/algorithm>
+#include <oneapi/dpl/execution>
+#include <oneapi/dpl/iterator>
+#include <iostream>
+#include <vector>
+#include <sycl/sycl.hpp>
+
+#include "utils.hpp"
+
+using namespace sycl;
+using namespace std;
+
+int main() {
+  // many small thumbnails, the sizes vary so the offsets are not a stride
+  int count = 2000;
+
+  vector<Img<ImgFormat::BMP>> thumbnails;
+  for (int k = 0; k < count; ++k) {
+    int32_t width = 96 + 16 * (k % 3);
+    int32_t height = 64 + 8 * (k % 5);
+    thumbnails.emplace_back(width, height);
+
+    size_t i = 0;
+    thumbnails.back().fill([&](ImgPixel& pixel) {
+      int32_t x = i % width, y = i / width;
+      pixel.set(uint8_t(x * y + k), uint8_t(x + y), uint8_t(x ^ k), 255);
+      ++i;
+    });
+  }
+
+  // Lambda to process image with gamma = 2, as in the gamma-correction sample
+  auto gamma_f = [](ImgPixel& pixel) {
+    auto v = (0.3f * pixel.r + 0.59f * pixel.g + 0.11f * pixel.b) / 255.0f;
+
+    auto gamma_pixel = static_cast<uint8_t>(255 * v * v);
+    pixel.set(gamma_pixel, gamma_pixel, gamma_pixel, gamma_pixel);
+  };
+
+  sycl::queue q;
+  auto policy = oneapi::dpl::execution::make_device_policy(q);
+
+  cout << "Run on " << q.get_device().get_info<info::device::name>() << "\n";
+  cout << count << " thumbnails\n\n";
+
+  // one launch and one buffer per image
+  auto single = thumbnails;
+  apply_pixels(policy, single[0], gamma_f);  // warm up
+  single = thumbnails;
+
+  auto start = get_time_in_sec();
+  for (auto& image : single) apply_pixels(policy, image, gamma_f);
+  auto single_time = get_time_in_sec() - start;
+
+  // one gather, one launch and one scatter for the whole batch
+  auto batched = thumbnails;
+  ImgBatch<> batch{q, batched};
+  apply_pixels(batch, gamma_f);  // warm up
+
+  start = get_time_in_sec();
+  batch.gather(batched);
+  apply_pixels(batch, gamma_f);
+  batch.scatter(batched);
+  auto batch_time = get_time_in_sec() - start;
+
+  int status = 0;
+  for (int k = 0; k < count; ++k) {
+    if (!equal(single[k].begin(), single[k].end(), batched[k].begin())) status = 1;
+  }
+
+  // per-image operation: the brightness depends on the image index
+  batch.gather(thumbnails);
+  apply_pixels(batch, [](ImgPixel& pixel, size_t k) { ImgBrightness{float(k % 64)}(pixel); });
+  batch.scatter(batched);
+  for (int k = 0; k < count; ++k) {
+    auto expected = thumbnails[k];
+    for (auto& pixel : expected) ImgBrightness{float(k % 64)}(pixel);
+    if (!equal(expected.begin(), expected.end(), batched[k].begin())) status = 1;
+  }
+
+  cout << "one launch per image : " << single_time << " s\n";
+  cout << "one batched launch   : " << batch_time << " s\n\n";
+
+  cout << (status == 0 ? "success\n" : "fail\n");
+  return status;
+}
@@ -0,0 +1,72 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <oneapi/dpl/algorithm>
+#include <oneapi/dpl/execution>
+#include <oneapi/dpl/iterator>
+#include <iostream>
+#include <sycl/sycl.hpp>
+
+#include "utils.hpp"
+
+using namespace sycl;
+using namespace std;
+
+int main() {
+  // Image size is width x height
+  int width = 1440;
+  int height = 960;
+
+  Img<ImgFormat::BMP> image{width, height};
+  image.fill(sycl::queue{}, ImgFractalFill<float>{ImgFractalFloat{width, height}});
+
+  // serial reference, the fractal is mostly dark so a few bins get most pixels
+  ImgHistogram reference{};
+  for (auto& pixel : image) ++reference[ImgLuminance(pixel)];
+
+  int status = 0;
+  for (auto& dev : device::get_devices()) {
+    sycl::queue q(dev);
+
+    ImgHistogram local = histogram(q, image, ImgHistogramMethod::local);
+    ImgHistogram atomics = histogram(q, image, ImgHistogramMethod::global_atomics);
+    if (local != reference || atomics != reference) status = 1;
+
+    double local_time =
+        best_time_in_sec([&] { histogram(q, image, ImgHistogramMethod::local); });
+    double atomics_time =
+        best_time_in_sec([&] { histogram(q, image, ImgHistogramMethod::global_atomics); });
+
+    cout << dev.get_info<info::device::name>() << "\n";
+    cout << "  local histograms   : " << local_time << " s\n";
+    cout << "  global atomics     : " << atomics_time << " s\n";
+    cout << "  results match      : " << (local == reference && atomics == reference ? "yes" : "no")
+         << "\n\n";
+  }
+
+  // histogram based operators on the default device
+  sycl::queue q;
+  Img<ImgFormat::BMP> equalized = image;
+  equalize(q, equalized);
+  equalized.write("fractal_equalized.bmp");
+
+  Img<ImgFormat::BMP> corrected = image;
+  float gamma = auto_gamma(q, corrected);
+  corrected.write("fractal_auto_gamma.bmp");
+
+  // after equalization the luminance levels are spread over the whole range
+  ImgHistogram spread = histogram(q, equalized);
+  int top = 255;
+  while (top > 0 && spread[top] == 0) --top;
+  if (top < 250) status = 1;
+
+  cout << "Automatic gamma " << gamma << "\n";
+  cout << (status == 0 ? "success\n" : "fail\n");
+  cout << "Equalized image is in fractal_equalized.bmp\n";
+  cout << "Image after automatic gamma correction is in fractal_auto_gamma.bmp\n";
+
+  return status;
+}
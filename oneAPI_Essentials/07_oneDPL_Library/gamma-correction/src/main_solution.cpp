@@ -22,7 +22,9 @@ int main() {
   int height = 960;
 
   Img<ImgFormat::BMP> image{width, height};
-  ImgFractal fractal{width, height};
+
+  // use default policy for algorithms execution
+  auto policy = oneapi::dpl::execution::dpcpp_default;
 
   // Lambda to process image with gamma = 2
   auto gamma_f = [](ImgPixel &pixel) {
@@ -33,19 +35,16 @@ int main() {
     pixel.set(gamma_pixel, gamma_pixel, gamma_pixel, gamma_pixel);
   };
 
-  // fill image with created fractal
-  int index = 0;
-  image.fill([&index, width, &fractal](ImgPixel &pixel) {
-    int x = index % width;
-    int y = index / width;
-
-    auto fractal_pixel = fractal(x, y);
-    if (fractal_pixel < 0) fractal_pixel = 0;
-    if (fractal_pixel > 255) fractal_pixel = 255;
-    pixel.set(fractal_pixel, fractal_pixel, fractal_pixel, fractal_pixel);
-
-    ++index;
-  });
+  // fill image with created fractal, every pixel is computed in parallel on the device
+  // double precision when the device supports it, otherwise float with a
+  // less magnified view that float can resolve (see utils/ImgAlgorithm.hpp)
+  auto start = get_time_in_sec();
+  if (policy.queue().get_device().has(aspect::fp64)) {
+    image.fill(policy.queue(), ImgFractalFill<double>{ImgFractal{width, height}});
+  } else {
+    image.fill(policy.queue(), ImgFractalFill<float>{ImgFractalFloat{width, height}});
+  }
+  cout << "Fractal generated in " << get_time_in_sec() - start << " seconds\n";
 
   string original_image = "fractal_original.png";
   string processed_image = "fractal_gamma.png";
@@ -55,8 +54,6 @@ int main() {
   // call standard serial function for correctness check
   image.fill(gamma_f);
 
-  // use default policy for algorithms execution
-  auto policy = oneapi::dpl::execution::dpcpp_default;
   // We need to have the scope to have data in image2 after buffer's destruction
   {
     //# STEP 1: Create a buffer for the image2
@@ -71,11 +68,14 @@ int main() {
   }
 
   image2.write(processed_image);
-  // check correctness
-  if (check(image.begin(), image.end(), image2.begin())) {
+  // check correctness, the comparison runs on the device in a single pass
+  auto stats = compare(policy.queue(), image, image2);
+  if (stats.equal()) {
     cout << "success\n";
   } else {
-    cout << "fail\n";
+    cout << "fail: " << stats.mismatches << " of " << stats.pixels
+         << " pixels differ, max channel error " << stats.maxError
+         << ", PSNR " << stats.psnr << " dB\n";
     return 1;
   }
   cout << "Run on "
@@ -0,0 +1,109 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <oneapi/dpl/algorithm>
+#include <oneapi/dpl/execution>
+#include <oneapi/dpl/iterator>
+#include <iostream>
+#include <sycl/sycl.hpp>
+
+#include "utils.hpp"
+
+using namespace sycl;
+using namespace std;
+
+int main() {
+  // Image size is width x height
+  int width = 1440;
+  int height = 960;
+
+  Img<ImgFormat::BMP> image{width, height};
+
+  // use default policy for algorithms execution
+  auto policy = oneapi::dpl::execution::dpcpp_default;
+
+  if (policy.queue().get_device().has(aspect::fp64)) {
+    image.fill(policy.queue(), ImgFractalFill<double>{ImgFractal{width, height}});
+  } else {
+    image.fill(policy.queue(), ImgFractalFill<float>{ImgFractalFloat{width, height}});
+  }
+
+  // chain of point operations: brightness, contrast, gamma, inverting table
+  ImgBrightness brightness{20};
+  ImgContrast contrast{1.5f};
+  ImgGamma gamma{0.8f};
+  ImgLut invert;
+  for (int i = 0; i < 256; ++i) invert.table[i] = static_cast<uint8_t>(255 - i);
+
+  auto pipeline = make_pipeline(brightness, contrast, gamma, invert);
+
+  // serial reference, one stage after the other
+  Img<ImgFormat::BMP> reference = image;
+  reference.fill(brightness);
+  reference.fill(contrast);
+  reference.fill(gamma);
+  reference.fill(invert);
+
+  // warm up, includes kernel JIT compilation
+  {
+    Img<ImgFormat::BMP> warm = image;
+    apply_pixels(policy, warm, pipeline);
+    apply_pixels(policy, warm, brightness);
+    apply_pixels(policy, warm, contrast);
+    apply_pixels(policy, warm, gamma);
+    apply_pixels(policy, warm, invert);
+  }
+
+  // 1. one buffer round trip per stage
+  Img<ImgFormat::BMP> staged = image;
+  auto start = get_time_in_sec();
+  apply_pixels(policy, staged, brightness);
+  apply_pixels(policy, staged, contrast);
+  apply_pixels(policy, staged, gamma);
+  apply_pixels(policy, staged, invert);
+  auto staged_time = get_time_in_sec() - start;
+
+  // 2. data resident in one buffer, one pass per stage
+  Img<ImgFormat::BMP> resident = image;
+  start = get_time_in_sec();
+  {
+    buffer<ImgPixel> b(resident.data(), width * height);
+    apply_pixels(policy, b, brightness);
+    apply_pixels(policy, b, contrast);
+    apply_pixels(policy, b, gamma);
+    apply_pixels(policy, b, invert);
+  }
+  auto resident_time = get_time_in_sec() - start;
+
+  // 3. all stages fused into a single pass
+  Img<ImgFormat::BMP> fused = image;
+  start = get_time_in_sec();
+  apply_pixels(policy, fused, pipeline);
+  auto fused_time = get_time_in_sec() - start;
+
+  cout << "Staged   (round trip per stage) : " << staged_time << " seconds\n";
+  cout << "Resident (pass per stage)       : " << resident_time << " seconds\n";
+  cout << "Fused    (single pass)          : " << fused_time << " seconds\n";
+
+  fused.write("fractal_pipeline.png");
+
+  // check correctness
+  if (check(reference.begin(), reference.end(), staged.begin()) &&
+      check(reference.begin(), reference.end(), resident.begin()) &&
+      check(reference.begin(), reference.end(), fused.begin())) {
+    cout << "success\n";
+  } else {
+    cout << "fail\n";
+    return 1;
+  }
+  cout << "Run on "
+       << policy.queue().get_device().template get_info<info::device::name>()
+       << "\n";
+  cout << "Image after applying the pipeline on the device is in "
+       << "fractal_pipeline.png\n";
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <oneapi/dpl/algorithm>
+#include <oneapi/dpl/execution>
+#include <oneapi/dpl/iterator>
+#include <iostream>
+#include <sycl/sycl.hpp>
+
+#include "utils.hpp"
+
+using namespace sycl;
+using namespace std;
+
+int main() {
+  // Image size is width x height
+  int width = 4096;
+  int height = 4096;
+
+  // Lambda to process image with gamma = 2, as in the gamma-correction sample
+  auto gamma_f = [](ImgPixel& pixel) {
+    auto v = (0.3f * pixel.r + 0.59f * pixel.g + 0.11f * pixel.b) / 255.0f;
+
+    auto gamma_pixel = static_cast<uint8_t>(255 * v * v);
+    pixel.set(gamma_pixel, gamma_pixel, gamma_pixel, gamma_pixel);
+  };
+
+  cout << "Image " << width << "x" << height << "\n\n";
+
+  int status = 0;
+  for (auto& dev : device::get_devices()) {
+    sycl::queue q(dev);
+    auto policy = oneapi::dpl::execution::make_device_policy(q);
+
+    using Image = Img<ImgFormat::BMP, ImgUsmStorage<>>;
+    Image source{width, height, ImgUsmStorage<>{q}};
+    source.fill(q, [](int32_t x, int32_t y) {
+      return ImgPixel{uint8_t(x * y), uint8_t(x + y), uint8_t(x ^ y), 255};
+    });
+
+    // packed: every work-item loads one 4 byte struct
+    Image packed = source;
+    apply_pixels(policy, packed, gamma_f);
+    double packed_time = best_time_in_sec([&] { apply_pixels(policy, packed, gamma_f); });
+
+    // planar: every work-item loads one byte of each plane
+    ImgPlanar<> planar{q, width, height};
+    double convert_time = best_time_in_sec([&] { to_planar(q, source, planar); });
+    apply_pixels(q, planar, gamma_f);
+    double planar_time = best_time_in_sec([&] { apply_pixels(q, planar, gamma_f); });
+
+    // one pass from the same source on both layouts must agree
+    Image expected = source;
+    Image result = source;
+    apply_pixels(policy, expected, gamma_f);
+    to_planar(q, source, planar);
+    apply_pixels(q, planar, gamma_f);
+    to_packed(q, planar, result);
+    auto stats = compare(q, expected, result);
+    if (!stats.equal()) status = 1;
+
+    cout << dev.get_info<info::device::name>() << "\n";
+    cout << "  packed gamma       : " << packed_time << " s\n";
+    cout << "  planar gamma       : " << planar_time << " s\n";
+    cout << "  packed -> planar   : " << convert_time << " s\n";
+    cout << "  layouts agree      : " << (stats.equal() ? "yes" : "no") << "\n\n";
+  }
+
+  cout << (status == 0 ? "success\n" : "fail\n");
+  return status;
+}
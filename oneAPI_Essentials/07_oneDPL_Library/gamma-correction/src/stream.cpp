@@ -0,0 +1,79 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <oneapi/dpl/algorithm>
+#include <oneapi/dpl/execution>
+#include <oneapi/dpl/iterator>
+#include <cstdlib>
+#include <iostream>
+#include <sycl/sycl.hpp>
+
+#include "utils.hpp"
+
+using namespace sycl;
+using namespace std;
+
+int main(int argc, char* argv[]) {
+  // Image size is width x height, streamed in strips of stripRows rows
+  int width = argc > 2 ? atoi(argv[1]) : 8192;
+  int height = argc > 2 ? atoi(argv[2]) : 8192;
+  int stripRows = argc > 3 ? atoi(argv[3]) : 256;
+
+  sycl::queue q;
+  ImgGammaLut gamma{make_gamma_table(2.0f)};
+
+  string input = "stream_input.bmp";
+  string output = "stream_gamma.bmp";
+
+  // input written straight into a mapped file, a cheap pattern instead of the fractal
+  {
+    Img<ImgFormat::BMP, ImgMappedBMP> image{width, height, ImgMappedBMP{input}};
+    image.fill(q, [](int32_t x, int32_t y) {
+      return ImgPixel{uint8_t(x ^ y), uint8_t(x), uint8_t(y), 255};
+    });
+    image.flush();
+  }
+
+  cout << "Image " << width << "x" << height << ", strips of " << stripRows
+       << " rows\n";
+
+  // one slot serializes read, upload, kernel, download and write;
+  // two and three slots overlap them
+  ImgStreamStats stats;
+  for (int slots = 1; slots <= 3; ++slots) {
+    auto start = get_time_in_sec();
+    if (!stream_pixels(q, input, output, gamma, stripRows, slots, &stats)) return 1;
+    auto seconds = get_time_in_sec() - start;
+
+    double megabytes = 2.0 * width * height * sizeof(ImgPixel) / 1e6;
+    cout << slots << " slot(s) : " << seconds << " seconds, "
+         << megabytes / seconds << " MB/s, " << stats.strips << " strips, "
+         << stats.stagingBytes / 1e6 << " MB staging\n";
+  }
+
+  // check correctness against the point operation applied on the host
+  Img<ImgFormat::BMP, ImgMappedBMP> source{ImgMappedBMP{input}};
+  Img<ImgFormat::BMP, ImgMappedBMP> result{ImgMappedBMP{output}};
+  bool ok = !source.empty() && !result.empty() && source.width() == result.width() &&
+            source.height() == result.height();
+  for (auto s = source.begin(), r = result.begin(); ok && s != source.end(); ++s, ++r) {
+    ImgPixel expected = *s;
+    gamma(expected);
+    ok = expected == *r;
+  }
+
+  if (ok) {
+    cout << "success\n";
+  } else {
+    cout << "fail\n";
+    return 1;
+  }
+  cout << "Run on " << q.get_device().get_info<info::device::name>() << "\n";
+  cout << "Image after applying gamma correction strip by strip is in " << output
+       << "\n";
+
+  return 0;
+}
@@ -9,8 +9,16 @@
 
 #include "utils/Img.hpp"
 #include "utils/ImgAlgorithm.hpp"
+#include "utils/ImgBatch.hpp"
+#include "utils/ImgCompare.hpp"
+#include "utils/ImgConvolution.hpp"
 #include "utils/ImgFormat.hpp"
+#include "utils/ImgGammaLut.hpp"
+#include "utils/ImgHistogram.hpp"
 #include "utils/ImgPixel.hpp"
+#include "utils/ImgPipeline.hpp"
+#include "utils/ImgPlanar.hpp"
+#include "utils/ImgStream.hpp"
 
 #include "utils/Other.hpp"
 
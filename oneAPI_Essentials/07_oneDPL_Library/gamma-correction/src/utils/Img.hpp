@@ -8,6 +8,9 @@
 #define _GAMMA_UTILS_IMG_HPP
 
 #include "ImgPixel.hpp"
+#include "ImgStorage.hpp"
+
+#include <sycl/sycl.hpp>
 
 #include <algorithm>
 #include <fstream>
@@ -17,23 +20,27 @@
 using namespace std;
 
 // Image class definition
-template <typename Format>
+// Storage decides where the pixels live, see ImgStorage.hpp
+template <typename Format, typename Storage = ImgVectorStorage>
 class Img {
  private:
   Format _format;
   int32_t _width;
   int32_t _height;
-  vector<ImgPixel> _pixels;
+  Storage _storage;
 
-  using Iterator = vector<ImgPixel>::iterator;
-  using ConstIterator = vector<ImgPixel>::const_iterator;
+  using Iterator = ImgPixel*;
+  using ConstIterator = ImgPixel const*;
 
  public:
   /////////////////////
   // SPECIAL METHODS //
   /////////////////////
 
-  Img(int32_t width, int32_t height);
+  Img(int32_t width, int32_t height, Storage storage = Storage());
+  // image over storage that already holds one, e.g. an existing mapped file;
+  // the image is empty() if the storage cannot be opened
+  explicit Img(Storage storage);
 
   void reset(int32_t width, int32_t height);
 
@@ -54,18 +61,27 @@ class Img {
 
   int32_t width() const noexcept;
   int32_t height() const noexcept;
+  // true if there are no pixels, e.g. the storage could not be opened
+  bool empty() const noexcept;
 
   ImgPixel const* data() const noexcept;
   ImgPixel* data() noexcept;
 
+  Storage const& storage() const noexcept;
+
   ///////////////////
   // FUNCTIONALITY //
   ///////////////////
 
   void write(string const& filename) const;
+  // makes the pixels durable in storage that is backed by a file
+  void flush();
 
   template <typename Functor>
   void fill(Functor f);
+  // parallel fill on the device, f(x, y) returns the pixel at column x, row y
+  template <typename Functor>
+  void fill(sycl::queue q, Functor f);
   void fill(ImgPixel pixel);
   void fill(ImgPixel pixel, int32_t row, int32_t col);
 };
@@ -74,89 +90,111 @@ class Img {
 // IMG CLASS IMPLEMENTATION: SPECIAL METHODS //
 ///////////////////////////////////////////////
 
-template <typename Format>
-Img<Format>::Img(int32_t width, int32_t height) : _format(width, height) {
-  _pixels.resize(width * height);
+template <typename Format, typename Storage>
+Img<Format, Storage>::Img(int32_t width, int32_t height, Storage storage)
+    : _format(width, height), _storage(move(storage)) {
+  _storage.resize(_format, width * height);
 
   _width = width;
   _height = height;
 }
 
-template <typename Format>
-void Img<Format>::reset(int32_t width, int32_t height) {
-  _pixels.resize(width * height);
+template <typename Format, typename Storage>
+Img<Format, Storage>::Img(Storage storage)
+    : _format(0, 0), _storage(move(storage)) {
+  _storage.open();
 
-  _width = width;
-  _height = height;
+  _width = _storage.width();
+  _height = _storage.height();
+
+  _format.reset(_width, _height);
+}
 
+template <typename Format, typename Storage>
+void Img<Format, Storage>::reset(int32_t width, int32_t height) {
   _format.reset(width, height);
+
+  _storage.resize(_format, width * height);
+
+  _width = width;
+  _height = height;
 }
 
 /////////////////////////////////////////
 // IMG CLASS IMPLEMENTATION: ITERATORS //
 /////////////////////////////////////////
 
-template <typename Format>
-typename Img<Format>::Iterator Img<Format>::begin() noexcept {
-  return _pixels.begin();
+template <typename Format, typename Storage>
+typename Img<Format, Storage>::Iterator Img<Format, Storage>::begin() noexcept {
+  return _storage.data();
 }
 
-template <typename Format>
-typename Img<Format>::Iterator Img<Format>::end() noexcept {
-  return _pixels.end();
+template <typename Format, typename Storage>
+typename Img<Format, Storage>::Iterator Img<Format, Storage>::end() noexcept {
+  return _storage.data() + _storage.size();
 }
 
-template <typename Format>
-typename Img<Format>::ConstIterator Img<Format>::begin() const noexcept {
-  return _pixels.begin();
+template <typename Format, typename Storage>
+typename Img<Format, Storage>::ConstIterator Img<Format, Storage>::begin() const noexcept {
+  return _storage.data();
 }
 
-template <typename Format>
-typename Img<Format>::ConstIterator Img<Format>::end() const noexcept {
-  return _pixels.end();
+template <typename Format, typename Storage>
+typename Img<Format, Storage>::ConstIterator Img<Format, Storage>::end() const noexcept {
+  return _storage.data() + _storage.size();
 }
 
-template <typename Format>
-typename Img<Format>::ConstIterator Img<Format>::cbegin() const noexcept {
-  return _pixels.begin();
+template <typename Format, typename Storage>
+typename Img<Format, Storage>::ConstIterator Img<Format, Storage>::cbegin() const noexcept {
+  return _storage.data();
 }
 
-template <typename Format>
-typename Img<Format>::ConstIterator Img<Format>::cend() const noexcept {
-  return _pixels.end();
+template <typename Format, typename Storage>
+typename Img<Format, Storage>::ConstIterator Img<Format, Storage>::cend() const noexcept {
+  return _storage.data() + _storage.size();
 }
 
 ///////////////////////////////////////
 // IMG CLASS IMPLEMENTATION: GETTERS //
 ///////////////////////////////////////
 
-template <typename Format>
-int32_t Img<Format>::width() const noexcept {
+template <typename Format, typename Storage>
+int32_t Img<Format, Storage>::width() const noexcept {
   return _width;
 }
 
-template <typename Format>
-int32_t Img<Format>::height() const noexcept {
+template <typename Format, typename Storage>
+int32_t Img<Format, Storage>::height() const noexcept {
   return _height;
 }
 
-template <typename Format>
-ImgPixel const* Img<Format>::data() const noexcept {
-  return _pixels.data();
+template <typename Format, typename Storage>
+bool Img<Format, Storage>::empty() const noexcept {
+  return _storage.size() == 0;
+}
+
+template <typename Format, typename Storage>
+ImgPixel const* Img<Format, Storage>::data() const noexcept {
+  return _storage.data();
+}
+
+template <typename Format, typename Storage>
+ImgPixel* Img<Format, Storage>::data() noexcept {
+  return _storage.data();
 }
 
-template <typename Format>
-ImgPixel* Img<Format>::data() noexcept {
-  return _pixels.data();
+template <typename Format, typename Storage>
+Storage const& Img<Format, Storage>::storage() const noexcept {
+  return _storage;
 }
 
 /////////////////////////////////////////////
 // IMG CLASS IMPLEMENTATION: FUNCTIONALITY //
 /////////////////////////////////////////////
 
-template <typename Format>
-void Img<Format>::write(string const& filename) const {
-  if (_pixels.empty()) {
+template <typename Format, typename Storage>
+void Img<Format, Storage>::write(string const& filename) const {
+  if (_storage.size() == 0) {
     cerr << "Img::write:: image is empty\n";
     return;
   }
@@ -166,30 +204,68 @@ void Img<Format>::write(string const& filename) const {
   _format.write(filestream, *this);
 }
 
-template <typename Format>
+template <typename Format, typename Storage>
+void Img<Format, Storage>::flush() {
+  _storage.flush();
+}
+
+template <typename Format, typename Storage>
 template <typename Functor>
-void Img<Format>::fill(Functor f) {
-  if (_pixels.empty()) {
+void Img<Format, Storage>::fill(Functor f) {
+  if (_storage.size() == 0) {
     cerr << "Img::fill(Functor): image is empty\n";
     return;
   }
 
-  for (auto& pixel : _pixels) f(pixel);
+  for (auto& pixel : *this) f(pixel);
+}
+
+template <typename Format, typename Storage>
+template <typename Functor>
+void Img<Format, Storage>::fill(sycl::queue q, Functor f) {
+  if (_storage.size() == 0) {
+    cerr << "Img::fill(queue, Functor): image is empty\n";
+    return;
+  }
+
+  int32_t width = _width;
+  sycl::range<2> size(_height, _width);
+
+  // USM storage is written in place
+  if constexpr (Storage::device_accessible) {
+    ImgPixel* pixels = _storage.data();
+    q.parallel_for(size, [=](sycl::id<2> i) {
+      int32_t y = i[0];
+      int32_t x = i[1];
+      pixels[y * width + x] = f(x, y);
+    }).wait();
+  } else {
+    // buffer destruction at the end of the scope copies the pixels back
+    sycl::buffer<ImgPixel> b(_storage.data(), _storage.size());
+    q.submit([&](sycl::handler& h) {
+      sycl::accessor pixels(b, h, sycl::write_only, sycl::no_init);
+      h.parallel_for(size, [=](sycl::id<2> i) {
+        int32_t y = i[0];
+        int32_t x = i[1];
+        pixels[y * width + x] = f(x, y);
+      });
+    });
+  }
 }
 
-template <typename Format>
-void Img<Format>::fill(ImgPixel pixel) {
-  if (_pixels.empty()) {
+template <typename Format, typename Storage>
+void Img<Format, Storage>::fill(ImgPixel pixel) {
+  if (_storage.size() == 0) {
     cerr << "Img::fill(ImgPixel): image is empty\n";
     return;
   }
 
-  fill(_pixels.begin(), _pixels.end(), pixel);
+  std::fill(begin(), end(), pixel);
 }
 
-template <typename Format>
-void Img<Format>::fill(ImgPixel pixel, int row, int col) {
-  if (_pixels.empty()) {
+template <typename Format, typename Storage>
+void Img<Format, Storage>::fill(ImgPixel pixel, int row, int col) {
+  if (_storage.size() == 0) {
     cerr << "Img::fill(ImgPixel): image is empty\n";
     return;
   }
@@ -199,7 +275,7 @@ void Img<Format>::fill(ImgPixel pixel, int row, int col) {
     return;
   }
 
-  _pixels.at(row * _width + col) = pixel;
+  _storage.data()[row * _width + col] = pixel;
 }
 
 #endif  // _GAMMA_UTILS_IMG_HPP
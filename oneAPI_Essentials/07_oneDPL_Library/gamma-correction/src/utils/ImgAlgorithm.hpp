@@ -7,34 +7,45 @@
 #ifndef _GAMMA_UTILS_IMGALGORITHM_HPP
 #define _GAMMA_UTILS_IMGALGORITHM_HPP
 
+#include "ImgPixel.hpp"
+
 #include <cmath>
 #include <cstdint>
+#include <type_traits>
 
 using namespace std;
 
 // struct to store fractal that image will fill from
-class ImgFractal {
+// Real is double for the reference image, float for devices without fp64 support.
+// The double view is magnified 2e6 times: one pixel step is about 5e-7, while
+// floats near the centre are only 6e-8 apart, so a float render of that view
+// is visibly quantized and the 1000 iterations amplify the rounding further.
+// The float version therefore shows the same centre magnified 2e4 times, where
+// it stays within a fraction of a grey level of a double render.
+template <typename Real>
+class BasicImgFractal {
  private:
   const int32_t _width;
   const int32_t _height;
 
-  double _cx = -0.7436;
-  double _cy = 0.1319;
+  Real _cx = -0.7436;
+  Real _cy = 0.1319;
 
-  double _magn = 2000000.0;
+  Real _magn = is_same_v<Real, float> ? 20000.0 : 2000000.0;
   int _maxIterations = 1000;
 
  public:
-  ImgFractal(int32_t width, int32_t height) : _width(width), _height(height) {}
+  BasicImgFractal(int32_t width, int32_t height)
+      : _width(width), _height(height) {}
 
-  double operator()(int32_t x, int32_t y) const {
-    double fx = (double(x) - double(_width) / 2) * (1 / _magn) + _cx;
-    double fy = (double(y) - double(_height) / 2) * (1 / _magn) + _cy;
+  Real operator()(int32_t x, int32_t y) const {
+    Real fx = (Real(x) - Real(_width) / 2) * (1 / _magn) + _cx;
+    Real fy = (Real(y) - Real(_height) / 2) * (1 / _magn) + _cy;
 
-    double res = 0;
-    double nx = 0;
-    double ny = 0;
-    double val = 0;
+    Real res = 0;
+    Real nx = 0;
+    Real ny = 0;
+    Real val = 0;
 
     for (int i = 0; nx * nx + ny * ny <= 4 && i < _maxIterations; ++i) {
       val = nx * nx - ny * ny + fx;
@@ -48,4 +59,21 @@ class ImgFractal {
   }
 };
 
+using ImgFractal = BasicImgFractal<double>;
+using ImgFractalFloat = BasicImgFractal<float>;
+
+// index-aware functor for Img::fill(queue, f): grey pixel of the clamped fractal value
+template <typename Real>
+struct ImgFractalFill {
+  BasicImgFractal<Real> fractal;
+
+  ImgPixel operator()(int32_t x, int32_t y) const {
+    Real value = fractal(x, y);
+    if (value < 0) value = 0;
+    if (value > 255) value = 255;
+    auto v = static_cast<uint8_t>(value);
+    return ImgPixel{v, v, v, v};
+  }
+};
+
 #endif  // _GAMMA_UTILS_IMGALGORITHM_HPP
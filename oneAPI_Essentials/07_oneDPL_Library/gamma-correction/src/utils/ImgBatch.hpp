@@ -0,0 +1,193 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef _GAMMA_UTILS_IMGBATCH_HPP
+#define _GAMMA_UTILS_IMGBATCH_HPP
+
+#include "Img.hpp"
+#include "ImgPixel.hpp"
+
+#include <sycl/sycl.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Batch of images packed back to back into one USM allocation. A table of
+// offsets (image k owns pixels offsets[k] .. offsets[k + 1]) lets a single
+// kernel process all images, so launch and transfer overhead is paid once
+// per batch instead of once per image, which dominates for small thumbnails.
+
+// trivially copyable view of the batch, used inside kernels
+struct ImgBatchView {
+  ImgPixel* pixels;
+  uint64_t const* offsets;
+  size_t count;
+
+  // index of the image that owns pixel i
+  size_t image_of(uint64_t i) const {
+    size_t lo = 0, hi = count;
+    while (hi - lo > 1) {
+      size_t mid = (lo + hi) / 2;
+      if (offsets[mid] <= i)
+        lo = mid;
+      else
+        hi = mid;
+    }
+    return lo;
+  }
+};
+
+template <sycl::usm::alloc Kind = sycl::usm::alloc::shared>
+class ImgBatch {
+ private:
+  sycl::queue _queue;
+  ImgPixel* _pixels = nullptr;
+  uint64_t* _offsets = nullptr;
+  vector<uint64_t> _hostOffsets;
+  vector<pair<int32_t, int32_t>> _sizes;
+
+ public:
+  // allocates room for the images and copies their pixels in
+  template <typename Image>
+  ImgBatch(sycl::queue queue, vector<Image> const& images) : _queue(queue) {
+    _hostOffsets.push_back(0);
+    for (auto& image : images) {
+      _sizes.emplace_back(image.width(), image.height());
+      _hostOffsets.push_back(_hostOffsets.back() + uint64_t(image.width()) * image.height());
+    }
+
+    _pixels = sycl::malloc<ImgPixel>(max<uint64_t>(size(), 1), _queue, Kind);
+    _offsets = sycl::malloc<uint64_t>(_hostOffsets.size(), _queue, Kind);
+    _queue.memcpy(_offsets, _hostOffsets.data(), _hostOffsets.size() * sizeof(uint64_t)).wait();
+    gather(images);
+  }
+
+  ImgBatch(ImgBatch const&) = delete;
+  ImgBatch& operator=(ImgBatch const&) = delete;
+
+  ImgBatch(ImgBatch&& other) noexcept
+      : _queue(other._queue),
+        _pixels(exchange(other._pixels, nullptr)),
+        _offsets(exchange(other._offsets, nullptr)),
+        _hostOffsets(move(other._hostOffsets)),
+        _sizes(move(other._sizes)) {}
+
+  ~ImgBatch() {
+    if (_pixels) sycl::free(_pixels, _queue);
+    if (_offsets) sycl::free(_offsets, _queue);
+  }
+
+  // number of images
+  size_t count() const noexcept { return _sizes.size(); }
+  // number of pixels of all images
+  size_t size() const noexcept { return _hostOffsets.back(); }
+
+  int32_t width(size_t k) const noexcept { return _sizes[k].first; }
+  int32_t height(size_t k) const noexcept { return _sizes[k].second; }
+
+  ImgPixel* data(size_t k) const noexcept { return _pixels + _hostOffsets[k]; }
+
+  sycl::queue queue() const { return _queue; }
+
+  ImgBatchView view() const noexcept { return {_pixels, _offsets, count()}; }
+
+  // copies the pixels of images (same count and sizes as the batch, pixels
+  // readable on the host) in
+  template <typename Image>
+  void gather(vector<Image> const& images);
+  // copies the pixels of the batch back to images
+  template <typename Image>
+  void scatter(vector<Image>& images) const;
+
+ private:
+  template <typename Image>
+  bool matches(vector<Image> const& images) const;
+};
+
+///////////////////////////////////
+// IMGBATCH CLASS IMPLEMENTATION //
+///////////////////////////////////
+
+template <sycl::usm::alloc Kind>
+template <typename Image>
+bool ImgBatch<Kind>::matches(vector<Image> const& images) const {
+  if (images.size() != count()) {
+    cerr << "ImgBatch: " << images.size() << " images for a batch of " << count() << "\n";
+    return false;
+  }
+  for (size_t k = 0; k < count(); ++k) {
+    if (images[k].width() != width(k) || images[k].height() != height(k)) {
+      cerr << "ImgBatch: image " << k << " does not match the batch layout\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+// shared and host allocations are packed directly on the host; device
+// allocations are packed into a host staging copy, so the batch always
+// moves with one transfer instead of one per image
+template <sycl::usm::alloc Kind>
+template <typename Image>
+void ImgBatch<Kind>::gather(vector<Image> const& images) {
+  if (!matches(images)) return;
+
+  if constexpr (Kind == sycl::usm::alloc::device) {
+    vector<ImgPixel> staging(size());
+    for (size_t k = 0; k < count(); ++k)
+      copy(images[k].begin(), images[k].end(), staging.begin() + _hostOffsets[k]);
+    _queue.memcpy(_pixels, staging.data(), size() * sizeof(ImgPixel)).wait();
+  } else {
+    for (size_t k = 0; k < count(); ++k) copy(images[k].begin(), images[k].end(), data(k));
+  }
+}
+
+template <sycl::usm::alloc Kind>
+template <typename Image>
+void ImgBatch<Kind>::scatter(vector<Image>& images) const {
+  if (!matches(images)) return;
+
+  ImgPixel const* pixels = _pixels;
+  vector<ImgPixel> staging;
+  if constexpr (Kind == sycl::usm::alloc::device) {
+    staging.resize(size());
+    sycl::queue q = _queue;
+    q.memcpy(staging.data(), _pixels, size() * sizeof(ImgPixel)).wait();
+    pixels = staging.data();
+  }
+
+  for (size_t k = 0; k < count(); ++k)
+    copy(pixels + _hostOffsets[k], pixels + _hostOffsets[k + 1], images[k].begin());
+}
+
+//////////////////////
+// POINT OPERATIONS //
+//////////////////////
+
+// one launch over every pixel of the batch. f(pixel) is the same point
+// operation as for a single image (ImgPipeline.hpp); f(pixel, k) also gets
+// the index of the image, e.g. to pick a per-image lookup table
+template <typename Functor, sycl::usm::alloc Kind>
+void apply_pixels(ImgBatch<Kind>& batch, Functor f) {
+  if (batch.size() == 0) return;
+
+  ImgBatchView view = batch.view();
+  batch.queue().parallel_for(sycl::range<1>(batch.size()), [=](sycl::id<1> i) {
+    ImgPixel& pixel = view.pixels[i[0]];
+    if constexpr (is_invocable_v<Functor, ImgPixel&, size_t>)
+      f(pixel, view.image_of(i[0]));
+    else
+      f(pixel);
+  }).wait();
+}
+
+#endif  // _GAMMA_UTILS_IMGBATCH_HPP
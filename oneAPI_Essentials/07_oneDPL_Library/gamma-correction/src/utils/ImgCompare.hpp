@@ -0,0 +1,132 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef _GAMMA_UTILS_IMGCOMPARE_HPP
+#define _GAMMA_UTILS_IMGCOMPARE_HPP
+
+#include "Img.hpp"
+#include "ImgPixel.hpp"
+
+#include <sycl/sycl.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+using namespace std;
+
+// result of comparing two images of the same size
+struct ImgDiffStats {
+  uint64_t pixels = 0;
+  uint64_t mismatches = 0;   // pixels with at least one differing channel
+  uint32_t maxError = 0;     // largest absolute difference of any channel
+  uint64_t squaredError = 0; // sum over all channels
+  double psnr = numeric_limits<double>::infinity();  // dB, infinite if equal
+
+  bool equal() const noexcept { return mismatches == 0; }
+};
+
+// per pixel part of the comparison, folded into three reductions
+struct ImgDiffOp {
+  template <typename Pixels, typename Mismatches, typename MaxError, typename Squared>
+  void operator()(Pixels const& a, Pixels const& b, size_t i, Mismatches& mismatches,
+                  MaxError& maxError, Squared& squared) const {
+    ImgPixel p = a[i];
+    ImgPixel q = b[i];
+    uint32_t db = p.b > q.b ? p.b - q.b : q.b - p.b;
+    uint32_t dg = p.g > q.g ? p.g - q.g : q.g - p.g;
+    uint32_t dr = p.r > q.r ? p.r - q.r : q.r - p.r;
+    uint32_t da = p.a > q.a ? p.a - q.a : q.a - p.a;
+    uint32_t e = max(max(db, dg), max(dr, da));
+
+    mismatches.combine(e != 0);
+    maxError.combine(e);
+    squared.combine(uint64_t(db * db + dg * dg + dr * dr + da * da));
+  }
+};
+
+inline ImgDiffStats make_diff_stats(uint64_t pixels, uint64_t mismatches,
+                                    uint32_t maxError, uint64_t squared) {
+  ImgDiffStats stats;
+  stats.pixels = pixels;
+  stats.mismatches = mismatches;
+  stats.maxError = maxError;
+  stats.squaredError = squared;
+  if (squared) {
+    double mse = double(squared) / (4.0 * pixels);
+    stats.psnr = 10 * log10(255.0 * 255.0 / mse);
+  }
+  return stats;
+}
+
+// one pass over n pixels; bind(h) returns the two pixel sources for the kernel
+template <typename Bind>
+ImgDiffStats submit_compare(sycl::queue q, size_t n, Bind bind) {
+  uint64_t mismatches = 0;
+  uint32_t maxError = 0;
+  uint64_t squared = 0;
+  {
+    sycl::buffer<uint64_t> buf_mismatches(&mismatches, 1);
+    sycl::buffer<uint32_t> buf_max(&maxError, 1);
+    sycl::buffer<uint64_t> buf_squared(&squared, 1);
+
+    q.submit([&](sycl::handler& h) {
+      auto sources = bind(h);
+      auto a = sources.first;
+      auto b = sources.second;
+
+      auto reduction_mismatches = sycl::reduction(buf_mismatches, h, sycl::plus<uint64_t>());
+      auto reduction_max = sycl::reduction(buf_max, h, sycl::maximum<uint32_t>());
+      auto reduction_squared = sycl::reduction(buf_squared, h, sycl::plus<uint64_t>());
+
+      h.parallel_for(sycl::range<1>(n), reduction_mismatches, reduction_max, reduction_squared,
+                     [=](sycl::id<1> i, auto& m, auto& e, auto& s) {
+        ImgDiffOp{}(a, b, i[0], m, e, s);
+      });
+    });
+  }
+  return make_diff_stats(n, mismatches, maxError, squared);
+}
+
+// pixels in USM
+inline ImgDiffStats compare_pixels(sycl::queue q, ImgPixel const* a, ImgPixel const* b,
+                                   size_t n) {
+  return submit_compare(q, n, [=](sycl::handler&) { return make_pair(a, b); });
+}
+
+// pixels in buffers of the same size
+inline ImgDiffStats compare_pixels(sycl::queue q, sycl::buffer<ImgPixel>& a,
+                                   sycl::buffer<ImgPixel>& b) {
+  return submit_compare(q, a.get_range()[0], [&](sycl::handler& h) {
+    return make_pair(sycl::accessor(a, h, sycl::read_only),
+                     sycl::accessor(b, h, sycl::read_only));
+  });
+}
+
+// device side replacement for check(): mismatch count, max channel error and
+// PSNR of two images in a single pass; images of different sizes mismatch
+// everywhere
+template <typename Format, typename StorageA, typename StorageB>
+ImgDiffStats compare(sycl::queue q, Img<Format, StorageA> const& a,
+                     Img<Format, StorageB> const& b) {
+  size_t n = size_t(a.width()) * a.height();
+  if (a.width() != b.width() || a.height() != b.height()) {
+    return make_diff_stats(n, n, 255, 255ull * 255 * 4 * n);
+  }
+  if (n == 0) return {};
+
+  if constexpr (StorageA::device_accessible && StorageB::device_accessible) {
+    return compare_pixels(q, a.data(), b.data(), n);
+  } else {
+    // read only buffers, nothing is copied back
+    sycl::buffer<ImgPixel> ba(a.data(), n);
+    sycl::buffer<ImgPixel> bb(b.data(), n);
+    return compare_pixels(q, ba, bb);
+  }
+}
+
+#endif  // _GAMMA_UTILS_IMGCOMPARE_HPP
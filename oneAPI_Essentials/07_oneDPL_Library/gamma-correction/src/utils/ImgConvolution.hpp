@@ -0,0 +1,334 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef _GAMMA_UTILS_IMGCONVOLUTION_HPP
+#define _GAMMA_UTILS_IMGCONVOLUTION_HPP
+
+#include "Img.hpp"
+#include "ImgPipeline.hpp"
+#include "ImgPixel.hpp"
+
+#include <sycl/sycl.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Separable 2D convolution: a horizontal 1D kernel over every row, then a
+// vertical 1D kernel over every column. Blue, green and red are filtered,
+// alpha is kept; borders repeat the edge pixel. Results are stored as
+// clamped absolute values, so derivative kernels (e.g. the Sobel pair)
+// produce edge strength.
+
+constexpr int IMG_CONV_MAX_RADIUS = 16;
+constexpr size_t IMG_CONV_ROW_GROUP = 128;  // work-items per image row
+constexpr size_t IMG_CONV_TILE = 16;        // vertical pass tile edge
+
+////////////////
+// 1D KERNELS //
+////////////////
+
+struct ImgKernel1D {
+  int radius = 0;
+  float weights[2 * IMG_CONV_MAX_RADIUS + 1] = {};
+};
+
+// explicit weights, an odd count of at most 2 * IMG_CONV_MAX_RADIUS + 1
+inline ImgKernel1D make_kernel(initializer_list<float> weights) {
+  ImgKernel1D kernel;
+  if (weights.size() % 2 == 0 || weights.size() > 2 * IMG_CONV_MAX_RADIUS + 1) {
+    cerr << "make_kernel: needs an odd number of at most "
+         << 2 * IMG_CONV_MAX_RADIUS + 1 << " weights\n";
+    kernel.weights[0] = 1;
+    return kernel;
+  }
+  kernel.radius = weights.size() / 2;
+  copy(weights.begin(), weights.end(), kernel.weights);
+  return kernel;
+}
+
+inline ImgKernel1D make_box_kernel(int radius) {
+  ImgKernel1D kernel;
+  kernel.radius = clamp(radius, 0, IMG_CONV_MAX_RADIUS);
+  fill_n(kernel.weights, 2 * kernel.radius + 1, 1.0f / (2 * kernel.radius + 1));
+  return kernel;
+}
+
+// normalized Gaussian, radius defaults to 3 sigma
+inline ImgKernel1D make_gaussian_kernel(float sigma, int radius = -1) {
+  ImgKernel1D kernel;
+  if (radius < 0) radius = static_cast<int>(ceil(3 * sigma));
+  kernel.radius = clamp(radius, 0, IMG_CONV_MAX_RADIUS);
+
+  float sum = 0;
+  for (int k = -kernel.radius; k <= kernel.radius; ++k) {
+    kernel.weights[k + kernel.radius] = exp(-0.5f * k * k / (sigma * sigma));
+    sum += kernel.weights[k + kernel.radius];
+  }
+  for (int k = 0; k <= 2 * kernel.radius; ++k) kernel.weights[k] /= sum;
+  return kernel;
+}
+
+/////////////////
+// DEVICE PATH //
+/////////////////
+
+// calls f with std::integral_constant<int, R>: R = radius for the unrolled
+// radii 1 to 4, R = 0 for the generic loop over a runtime radius
+template <typename F>
+void with_radius(int radius, F f) {
+  switch (radius) {
+    case 1: f(integral_constant<int, 1>{}); break;
+    case 2: f(integral_constant<int, 2>{}); break;
+    case 3: f(integral_constant<int, 3>{}); break;
+    case 4: f(integral_constant<int, 4>{}); break;
+    default: f(integral_constant<int, 0>{}); break;
+  }
+}
+
+inline sycl::float4 ImgToFloat4(ImgPixel pixel) {
+  return sycl::float4(pixel.b, pixel.g, pixel.r, pixel.a);
+}
+
+// rows -> tmp; one work-group per row. Every sub-group loads a run of pixels
+// and takes the neighbours from the other lanes with select_from_group; the
+// outer radius lanes on each side only supply halo values, so a sub-group of
+// S lanes produces S - 2 * radius outputs per step. Sub-groups too narrow
+// for the radius read their neighbours from memory instead.
+template <int Radius, typename Pixels>
+void submit_horizontal(sycl::handler& h, Pixels in, sycl::float4* tmp, int32_t width,
+                       int32_t height, ImgKernel1D kernel) {
+  sycl::nd_range<2> range({size_t(height), IMG_CONV_ROW_GROUP}, {1, IMG_CONV_ROW_GROUP});
+  h.parallel_for(range, [=](sycl::nd_item<2> item) {
+    const int r = Radius > 0 ? Radius : kernel.radius;
+    const size_t row = size_t(item.get_global_id(0)) * width;
+    auto load = [&](int x) { return ImgToFloat4(in[row + sycl::clamp(x, 0, width - 1)]); };
+
+    auto sg = item.get_sub_group();
+    const int lanes = sg.get_local_range()[0];
+    const int lane = sg.get_local_id()[0];
+
+    if (2 * r < lanes) {
+      const int step = lanes - 2 * r;
+      const int stride = sg.get_group_range()[0] * step;
+      for (int base = sg.get_group_id()[0] * step; base < width; base += stride) {
+        int x = base - r + lane;
+        sycl::float4 v = load(x);
+        float b = 0, g = 0, rd = 0;
+#pragma unroll
+        for (int k = -r; k <= r; ++k) {
+          int src = sycl::clamp(lane + k, 0, lanes - 1);
+          float w = kernel.weights[k + r];
+          b += w * sycl::select_from_group(sg, v.x(), src);
+          g += w * sycl::select_from_group(sg, v.y(), src);
+          rd += w * sycl::select_from_group(sg, v.z(), src);
+        }
+        if (lane >= r && lane < lanes - r && x < width)
+          tmp[row + x] = sycl::float4(b, g, rd, v.w());
+      }
+    } else {
+      for (int x = item.get_local_id(1); x < width; x += IMG_CONV_ROW_GROUP) {
+        sycl::float4 sum(0, 0, 0, 0);
+#pragma unroll
+        for (int k = -r; k <= r; ++k) sum += kernel.weights[k + r] * load(x + k);
+        tmp[row + x] = sycl::float4(sum.x(), sum.y(), sum.z(), load(x).w());
+      }
+    }
+  });
+}
+
+// tmp -> pixels; every work-group stages a tile of IMG_CONV_TILE columns and
+// IMG_CONV_TILE + 2 * radius rows (the tile plus its halo) in local memory
+template <int Radius, typename Pixels>
+void submit_vertical(sycl::handler& h, sycl::float4 const* tmp, Pixels out, int32_t width,
+                     int32_t height, ImgKernel1D kernel) {
+  const int r = Radius > 0 ? Radius : kernel.radius;
+  sycl::local_accessor<sycl::float4, 2> tile(
+      sycl::range<2>(IMG_CONV_TILE + 2 * r, IMG_CONV_TILE), h);
+
+  auto up = [](size_t n) { return (n + IMG_CONV_TILE - 1) / IMG_CONV_TILE * IMG_CONV_TILE; };
+  sycl::nd_range<2> range({up(height), up(width)}, {IMG_CONV_TILE, IMG_CONV_TILE});
+  h.parallel_for(range, [=](sycl::nd_item<2> item) {
+    const int r = Radius > 0 ? Radius : kernel.radius;
+    const int ly = item.get_local_id(0);
+    const int lx = item.get_local_id(1);
+    const int y0 = item.get_group(0) * IMG_CONV_TILE;
+    const int x = sycl::min(int(item.get_global_id(1)), width - 1);
+
+    for (int ty = ly; ty < int(IMG_CONV_TILE) + 2 * r; ty += IMG_CONV_TILE) {
+      int y = sycl::clamp(y0 + ty - r, 0, height - 1);
+      tile[ty][lx] = tmp[size_t(y) * width + x];
+    }
+    sycl::group_barrier(item.get_group());
+
+    sycl::float4 sum(0, 0, 0, 0);
+#pragma unroll
+    for (int k = 0; k <= 2 * r; ++k) sum += kernel.weights[k] * tile[ly + k][lx];
+
+    int y = item.get_global_id(0);
+    if (y < height && int(item.get_global_id(1)) < width) {
+      out[size_t(y) * width + x] =
+          ImgPixel{ImgClamp(sycl::fabs(sum.x())), ImgClamp(sycl::fabs(sum.y())),
+                   ImgClamp(sycl::fabs(sum.z())), uint8_t(tile[ly + r][lx].w())};
+    }
+  });
+}
+
+template <typename Format, typename Storage>
+void convolve_device(sycl::queue q, Img<Format, Storage>& image, ImgKernel1D const& horizontal,
+                     ImgKernel1D const& vertical) {
+  int32_t width = image.width();
+  int32_t height = image.height();
+  size_t n = size_t(width) * height;
+  sycl::float4* tmp = sycl::malloc_device<sycl::float4>(n, q);
+
+  // tmp is plain USM, the vertical pass must wait for the horizontal one
+  // explicitly on an out-of-order queue
+  sycl::event rows_done;
+
+  if constexpr (Storage::device_accessible) {
+    ImgPixel* pixels = image.data();
+    with_radius(horizontal.radius, [&](auto R) {
+      rows_done = q.submit([&](sycl::handler& h) {
+        submit_horizontal<decltype(R)::value>(h, pixels, tmp, width, height, horizontal);
+      });
+    });
+    with_radius(vertical.radius, [&](auto R) {
+      q.submit([&](sycl::handler& h) {
+        h.depends_on(rows_done);
+        submit_vertical<decltype(R)::value>(h, tmp, pixels, width, height, vertical);
+      });
+    });
+    q.wait();
+  } else {
+    // buffer destruction at the end of the scope copies the pixels back
+    sycl::buffer<ImgPixel> b(image.data(), n);
+    with_radius(horizontal.radius, [&](auto R) {
+      rows_done = q.submit([&](sycl::handler& h) {
+        sycl::accessor pixels(b, h, sycl::read_only);
+        submit_horizontal<decltype(R)::value>(h, pixels, tmp, width, height, horizontal);
+      });
+    });
+    with_radius(vertical.radius, [&](auto R) {
+      q.submit([&](sycl::handler& h) {
+        h.depends_on(rows_done);
+        sycl::accessor pixels(b, h, sycl::write_only, sycl::no_init);
+        submit_vertical<decltype(R)::value>(h, tmp, pixels, width, height, vertical);
+      });
+    });
+  }
+
+  sycl::free(tmp, q);
+}
+
+///////////////
+// HOST PATH //
+///////////////
+
+// CPU fallback: each channel is a float plane, rows are padded with their edge
+// pixels, and the innermost loops run over x with unit stride so that they
+// vectorize
+template <typename Format, typename Storage>
+void convolve_host(Img<Format, Storage>& image, ImgKernel1D const& horizontal,
+                   ImgKernel1D const& vertical) {
+  int32_t width = image.width();
+  int32_t height = image.height();
+  size_t n = size_t(width) * height;
+  ImgPixel* pixels = image.data();
+
+  vector<float> planes[3], tmp[3];
+  for (int c = 0; c < 3; ++c) {
+    planes[c].resize(n);
+    tmp[c].assign(n, 0);
+  }
+  for (size_t i = 0; i < n; ++i) {
+    planes[0][i] = pixels[i].b;
+    planes[1][i] = pixels[i].g;
+    planes[2][i] = pixels[i].r;
+  }
+
+  int rh = horizontal.radius;
+  vector<float> padded(width + 2 * rh);
+  for (int c = 0; c < 3; ++c) {
+    for (int32_t y = 0; y < height; ++y) {
+      float const* src = planes[c].data() + size_t(y) * width;
+      float* dst = tmp[c].data() + size_t(y) * width;
+      fill_n(padded.begin(), rh, src[0]);
+      copy(src, src + width, padded.begin() + rh);
+      fill_n(padded.begin() + rh + width, rh, src[width - 1]);
+
+      for (int k = 0; k <= 2 * rh; ++k) {
+        float w = horizontal.weights[k];
+        float const* p = padded.data() + k;
+#pragma omp simd
+        for (int32_t x = 0; x < width; ++x) dst[x] += w * p[x];
+      }
+    }
+  }
+
+  int rv = vertical.radius;
+  vector<float> row(width);
+  for (int32_t y = 0; y < height; ++y) {
+    ImgPixel* out = pixels + size_t(y) * width;
+    for (int c = 0; c < 3; ++c) {
+      fill(row.begin(), row.end(), 0.0f);
+      for (int k = -rv; k <= rv; ++k) {
+        float w = vertical.weights[k + rv];
+        float const* src = tmp[c].data() + size_t(clamp(y + k, 0, height - 1)) * width;
+#pragma omp simd
+        for (int32_t x = 0; x < width; ++x) row[x] += w * src[x];
+      }
+      for (int32_t x = 0; x < width; ++x) {
+        uint8_t v = ImgClamp(fabs(row[x]));
+        if (c == 0) out[x].b = v;
+        if (c == 1) out[x].g = v;
+        if (c == 2) out[x].r = v;
+      }
+    }
+  }
+}
+
+/////////////////////
+// IMG CONVOLUTION //
+/////////////////////
+
+enum class ImgConvPath { automatic, device, host };
+
+// horizontal then vertical pass over the image in place; automatic uses the
+// host path for CPU devices and the tiled kernels everywhere else
+template <typename Format, typename Storage>
+void convolve_separable(sycl::queue q, Img<Format, Storage>& image,
+                        ImgKernel1D const& horizontal, ImgKernel1D const& vertical,
+                        ImgConvPath path = ImgConvPath::automatic) {
+  if (image.width() == 0 || image.height() == 0) {
+    cerr << "convolve_separable: image is empty\n";
+    return;
+  }
+
+  if (path == ImgConvPath::automatic)
+    path = q.get_device().is_cpu() ? ImgConvPath::host : ImgConvPath::device;
+
+  if (path == ImgConvPath::host)
+    convolve_host(image, horizontal, vertical);
+  else
+    convolve_device(q, image, horizontal, vertical);
+}
+
+// the same kernel in both directions, e.g. Gaussian or box blur
+template <typename Format, typename Storage>
+void convolve_separable(sycl::queue q, Img<Format, Storage>& image, ImgKernel1D const& kernel,
+                        ImgConvPath path = ImgConvPath::automatic) {
+  convolve_separable(q, image, kernel, kernel, path);
+}
+
+#endif  // _GAMMA_UTILS_IMGCONVOLUTION_HPP
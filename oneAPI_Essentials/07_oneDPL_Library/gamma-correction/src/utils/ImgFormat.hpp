@@ -9,6 +9,7 @@
 
 #include "ImgPixel.hpp"
 
+#include <cstring>
 #include <fstream>
 
 using namespace std;
@@ -56,7 +57,7 @@ struct BMP {
   void reset(int32_t width, int32_t height) noexcept {
     uint32_t padSize = (4 - (width * sizeof(ImgPixel)) % 4) % 4;
     uint32_t mapSize = width * height * sizeof(ImgPixel) + height * padSize;
-    uint32_t allSize = mapSize + _fileHeader.sizeRest + _infoHeader.size;
+    uint32_t allSize = mapSize + 14 + 40;
 
     _fileHeader.sizeRest = 14;  // file header size in bytes
     _fileHeader.type = 0x4d42;
@@ -77,8 +78,19 @@ struct BMP {
     _infoHeader.clrImportant = 0;
   }
 
-  template <template <class> class Image, typename Format>
-  void write(ofstream& ostream, Image<Format> const& image) const {
+  // bytes in front of the pixel array
+  size_t headerSize() const noexcept {
+    return _fileHeader.sizeRest + _infoHeader.size;
+  }
+
+  // headers as they appear in the file, dst holds headerSize() bytes
+  void writeHeader(char* dst) const noexcept {
+    memcpy(dst, &_fileHeader.type, _fileHeader.sizeRest);
+    memcpy(dst + _fileHeader.sizeRest, &_infoHeader, _infoHeader.size);
+  }
+
+  template <typename Image>
+  void write(ofstream& ostream, Image const& image) const {
     ostream.write(reinterpret_cast<char const*>(&_fileHeader.type),
                   _fileHeader.sizeRest);
 
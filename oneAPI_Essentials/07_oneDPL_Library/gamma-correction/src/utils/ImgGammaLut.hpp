@@ -0,0 +1,85 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef _GAMMA_UTILS_IMGGAMMALUT_HPP
+#define _GAMMA_UTILS_IMGGAMMALUT_HPP
+
+#include "ImgPixel.hpp"
+
+#include <sycl/sycl.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+// 8 bit input has only 256 luminance levels, so the gamma curve for any gamma
+// is a 256 entry table computed once on the host
+using ImgGammaTable = array<uint8_t, 256>;
+
+inline ImgGammaTable make_gamma_table(float gamma) {
+  ImgGammaTable table;
+  for (int i = 0; i < 256; ++i) {
+    auto v = 255 * pow(i / 255.0f, gamma);
+    table[i] = static_cast<uint8_t>(v < 255 ? v : 255);
+  }
+  return table;
+}
+
+// 0.3 r + 0.59 g + 0.11 b with integer weights summing to 256
+inline uint8_t ImgLuminance(ImgPixel const& pixel) {
+  return static_cast<uint8_t>((77 * pixel.r + 151 * pixel.g + 28 * pixel.b + 128) >> 8);
+}
+
+// table driven counterpart of the gamma_f functor: integer luminance, one byte
+// gather, grey result in every channel; a plain loop over it vectorizes on the
+// CPU, e.g. std::for_each(oneapi::dpl::execution::par_unseq, ...)
+struct ImgGammaLut {
+  ImgGammaTable table;
+
+  void operator()(ImgPixel& pixel) const {
+    auto v = table[ImgLuminance(pixel)];
+    pixel.set(v, v, v, v);
+  }
+};
+
+// device path: each work-group stages the table in local memory once and then
+// corrects GAMMA_LUT_PIXELS pixels per work-item, strided by the group size
+// so that neighbouring work-items touch neighbouring pixels
+constexpr size_t GAMMA_LUT_GROUP = 256;
+constexpr size_t GAMMA_LUT_PIXELS = 16;
+
+inline sycl::event apply_gamma_lut(sycl::queue q, sycl::buffer<ImgPixel>& b,
+                                   sycl::buffer<uint8_t>& table) {
+  size_t n = b.get_range()[0];
+  size_t chunk = GAMMA_LUT_GROUP * GAMMA_LUT_PIXELS;
+  size_t groups = (n + chunk - 1) / chunk;
+
+  return q.submit([&](sycl::handler& h) {
+    sycl::accessor pixels(b, h, sycl::read_write);
+    sycl::accessor global_table(table, h, sycl::read_only);
+    sycl::local_accessor<uint8_t, 1> local_table(GAMMA_LUT_GROUP, h);
+
+    h.parallel_for(sycl::nd_range<1>(groups * GAMMA_LUT_GROUP, GAMMA_LUT_GROUP),
+                   [=](sycl::nd_item<1> item) {
+      size_t l = item.get_local_id(0);
+      local_table[l] = global_table[l];
+      sycl::group_barrier(item.get_group());
+
+      size_t base = item.get_group(0) * chunk + l;
+      for (size_t k = 0; k < GAMMA_LUT_PIXELS; ++k) {
+        size_t i = base + k * GAMMA_LUT_GROUP;
+        if (i < n) {
+          auto v = local_table[ImgLuminance(pixels[i])];
+          pixels[i] = ImgPixel{v, v, v, v};
+        }
+      }
+    });
+  });
+}
+
+#endif  // _GAMMA_UTILS_IMGGAMMALUT_HPP
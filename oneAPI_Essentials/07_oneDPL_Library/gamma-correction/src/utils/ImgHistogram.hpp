@@ -0,0 +1,179 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef _GAMMA_UTILS_IMGHISTOGRAM_HPP
+#define _GAMMA_UTILS_IMGHISTOGRAM_HPP
+
+#include <oneapi/dpl/execution>
+
+#include "Img.hpp"
+#include "ImgGammaLut.hpp"
+#include "ImgPipeline.hpp"
+#include "ImgPixel.hpp"
+
+#include <sycl/sycl.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+// 256 bin histogram of the integer luminance (ImgLuminance)
+using ImgHistogram = array<uint32_t, 256>;
+
+enum class ImgHistogramMethod {
+  local,          // per work-group histograms in local memory, merged at the end
+  global_atomics  // one global atomic increment per pixel
+};
+
+constexpr size_t HISTOGRAM_GROUP = 256;   // work-items per group, one bin each
+constexpr size_t HISTOGRAM_PIXELS = 64;   // pixels per work-item
+
+///////////////////////
+// HISTOGRAM KERNELS //
+///////////////////////
+
+// naive version: every pixel increments a global bin, images with few
+// distinct levels make many work-items contend on the same bins
+template <typename Pixels>
+void submit_histogram_atomics(sycl::handler& h, Pixels pixels, size_t n, uint32_t* bins) {
+  h.parallel_for(sycl::range<1>(n), [=](sycl::id<1> i) {
+    sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed, sycl::memory_scope::device,
+                     sycl::access::address_space::global_space>
+        bin(bins[ImgLuminance(pixels[i[0]])]);
+    bin += 1u;
+  });
+}
+
+// privatized version: every work-group counts HISTOGRAM_GROUP * HISTOGRAM_PIXELS
+// pixels into its own local histogram, contention is limited to the group,
+// and only the non-empty bins are added to the global histogram
+template <typename Pixels>
+void submit_histogram_local(sycl::handler& h, Pixels pixels, size_t n, uint32_t* bins) {
+  size_t chunk = HISTOGRAM_GROUP * HISTOGRAM_PIXELS;
+  size_t groups = (n + chunk - 1) / chunk;
+  sycl::local_accessor<uint32_t, 1> local_bins(256, h);
+
+  h.parallel_for(sycl::nd_range<1>(groups * HISTOGRAM_GROUP, HISTOGRAM_GROUP),
+                 [=](sycl::nd_item<1> item) {
+    size_t l = item.get_local_id(0);
+    local_bins[l] = 0;
+    sycl::group_barrier(item.get_group());
+
+    size_t base = item.get_group(0) * chunk + l;
+    for (size_t k = 0; k < HISTOGRAM_PIXELS; ++k) {
+      size_t i = base + k * HISTOGRAM_GROUP;
+      if (i < n) {
+        sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed, sycl::memory_scope::work_group,
+                         sycl::access::address_space::local_space>
+            bin(local_bins[ImgLuminance(pixels[i])]);
+        bin += 1u;
+      }
+    }
+    sycl::group_barrier(item.get_group());
+
+    if (local_bins[l]) {
+      sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed, sycl::memory_scope::device,
+                       sycl::access::address_space::global_space>
+          bin(bins[l]);
+      bin += local_bins[l];
+    }
+  });
+}
+
+template <typename Format, typename Storage>
+ImgHistogram histogram(sycl::queue q, Img<Format, Storage> const& image,
+                       ImgHistogramMethod method = ImgHistogramMethod::local) {
+  ImgHistogram result{};
+  size_t n = size_t(image.width()) * image.height();
+  if (n == 0) return result;
+
+  uint32_t* bins = sycl::malloc_device<uint32_t>(256, q);
+  q.memset(bins, 0, 256 * sizeof(uint32_t)).wait();
+
+  auto submit = [&](sycl::handler& h, auto pixels) {
+    if (method == ImgHistogramMethod::local)
+      submit_histogram_local(h, pixels, n, bins);
+    else
+      submit_histogram_atomics(h, pixels, n, bins);
+  };
+
+  if constexpr (Storage::device_accessible) {
+    ImgPixel const* pixels = image.data();
+    q.submit([&](sycl::handler& h) { submit(h, pixels); }).wait();
+  } else {
+    sycl::buffer<ImgPixel> b(image.data(), n);
+    q.submit([&](sycl::handler& h) {
+      sycl::accessor pixels(b, h, sycl::read_only);
+      submit(h, pixels);
+    }).wait();
+  }
+
+  q.memcpy(result.data(), bins, 256 * sizeof(uint32_t)).wait();
+  sycl::free(bins, q);
+  return result;
+}
+
+////////////////////////////
+// HISTOGRAM BASED TABLES //
+////////////////////////////
+
+// maps luminance levels so that the cumulative histogram becomes linear
+inline ImgGammaTable make_equalization_table(ImgHistogram const& hist) {
+  ImgGammaTable table;
+  uint64_t total = 0, first = 0;
+  for (auto count : hist) total += count;
+  for (auto count : hist) {
+    if (count) {
+      first = count;
+      break;
+    }
+  }
+
+  uint64_t cdf = 0;
+  for (int i = 0; i < 256; ++i) {
+    cdf += hist[i];
+    table[i] = total > first
+                   ? static_cast<uint8_t>(lround(255.0 * (cdf - min(cdf, first)) / (total - first)))
+                   : static_cast<uint8_t>(i);
+  }
+  return table;
+}
+
+// gamma that maps the mean luminance to mid grey
+inline float auto_gamma_value(ImgHistogram const& hist) {
+  double total = 0, sum = 0;
+  for (int i = 0; i < 256; ++i) {
+    total += hist[i];
+    sum += double(i) * hist[i];
+  }
+  double mean = total ? sum / total / 255.0 : 0.5;
+  if (mean <= 0.0 || mean >= 1.0) return 1.0f;
+  return static_cast<float>(log(0.5) / log(mean));
+}
+
+///////////////////
+// IMG OPERATORS //
+///////////////////
+
+// histogram equalization applied to every color channel through one table
+template <typename Format, typename Storage>
+void equalize(sycl::queue q, Img<Format, Storage>& image) {
+  ImgLut lut{make_equalization_table(histogram(q, image))};
+  apply_pixels(oneapi::dpl::execution::make_device_policy(q), image, lut);
+}
+
+// gamma correction with the gamma chosen from the histogram, returns the gamma
+template <typename Format, typename Storage>
+float auto_gamma(sycl::queue q, Img<Format, Storage>& image) {
+  float gamma = auto_gamma_value(histogram(q, image));
+  ImgLut lut{make_gamma_table(gamma)};
+  apply_pixels(oneapi::dpl::execution::make_device_policy(q), image, lut);
+  return gamma;
+}
+
+#endif  // _GAMMA_UTILS_IMGHISTOGRAM_HPP
@@ -0,0 +1,156 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef _GAMMA_UTILS_IMGPIPELINE_HPP
+#define _GAMMA_UTILS_IMGPIPELINE_HPP
+
+#include <oneapi/dpl/algorithm>
+#include <oneapi/dpl/execution>
+#include <oneapi/dpl/iterator>
+
+#include "Img.hpp"
+#include "ImgPixel.hpp"
+
+#include <sycl/sycl.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+//////////////////////
+// POINT OPERATIONS //
+//////////////////////
+
+// every operation is a small trivially copyable functor updating one pixel in
+// place, so it can run on the host with Img::fill or inside a device kernel
+
+inline uint8_t ImgClamp(float value) {
+  if (value < 0) return 0;
+  if (value > 255) return 255;
+  return static_cast<uint8_t>(value);
+}
+
+// adds delta to the color channels
+struct ImgBrightness {
+  float delta;
+
+  void operator()(ImgPixel& pixel) const {
+    pixel.set(ImgClamp(pixel.b + delta), ImgClamp(pixel.g + delta),
+              ImgClamp(pixel.r + delta), pixel.a);
+  }
+};
+
+// scales the color channels around mid grey
+struct ImgContrast {
+  float factor;
+
+  void operator()(ImgPixel& pixel) const {
+    pixel.set(ImgClamp((pixel.b - 128) * factor + 128),
+              ImgClamp((pixel.g - 128) * factor + 128),
+              ImgClamp((pixel.r - 128) * factor + 128), pixel.a);
+  }
+};
+
+// replaces the color channels by the luminance
+struct ImgGrayscale {
+  void operator()(ImgPixel& pixel) const {
+    auto v = ImgClamp(0.3f * pixel.r + 0.59f * pixel.g + 0.11f * pixel.b);
+    pixel.set(v, v, v, pixel.a);
+  }
+};
+
+// per channel gamma curve, 255 * (c / 255) ^ gamma
+struct ImgGamma {
+  float gamma;
+
+  void operator()(ImgPixel& pixel) const {
+    pixel.set(curve(pixel.b), curve(pixel.g), curve(pixel.r), pixel.a);
+  }
+
+ private:
+  uint8_t curve(uint8_t c) const { return ImgClamp(255 * pow(c / 255.0f, gamma)); }
+};
+
+// per channel lookup table
+struct ImgLut {
+  array<uint8_t, 256> table;
+
+  void operator()(ImgPixel& pixel) const {
+    pixel.set(table[pixel.b], table[pixel.g], table[pixel.r], pixel.a);
+  }
+};
+
+//////////////
+// PIPELINE //
+//////////////
+
+// compile time composition of point operations, applied first to last;
+// a pipeline is itself a point operation, so all stages run in a single pass
+// and every pixel is read and written once however many stages there are
+template <typename... Ops>
+struct ImgPipeline;
+
+template <>
+struct ImgPipeline<> {
+  void operator()(ImgPixel&) const {}
+
+  template <typename Next>
+  ImgPipeline<Next> then(Next next) const {
+    return {next, {}};
+  }
+};
+
+template <typename Op, typename... Rest>
+struct ImgPipeline<Op, Rest...> {
+  Op op;
+  ImgPipeline<Rest...> rest;
+
+  void operator()(ImgPixel& pixel) const {
+    op(pixel);
+    rest(pixel);
+  }
+
+  // new pipeline with next appended as the last stage
+  template <typename Next>
+  ImgPipeline<Op, Rest..., Next> then(Next next) const {
+    return {op, rest.then(next)};
+  }
+};
+
+inline ImgPipeline<> make_pipeline() { return {}; }
+
+template <typename Op, typename... Rest>
+ImgPipeline<Op, Rest...> make_pipeline(Op op, Rest... rest) {
+  return {op, make_pipeline(rest...)};
+}
+
+//////////////////////
+// DEVICE EXECUTION //
+//////////////////////
+
+// one pass of f over pixels that are already resident in b; several calls on
+// the same buffer keep the data on the device in between
+template <typename Policy, typename Functor>
+void apply_pixels(Policy&& policy, sycl::buffer<ImgPixel>& b, Functor f) {
+  std::for_each(policy, oneapi::dpl::begin(b), oneapi::dpl::end(b), f);
+}
+
+// one pass of f over the image; USM storage is processed in place, other
+// storage gets a single upload and download around the kernel
+template <typename Policy, typename Format, typename Storage, typename Functor>
+void apply_pixels(Policy&& policy, Img<Format, Storage>& image, Functor f) {
+  if constexpr (Storage::device_accessible) {
+    std::for_each(policy, image.begin(), image.end(), f);
+  } else {
+    // buffer destruction at the end of the scope copies the pixels back
+    sycl::buffer<ImgPixel> b(image.data(), image.width() * image.height());
+    apply_pixels(policy, b, f);
+  }
+}
+
+#endif  // _GAMMA_UTILS_IMGPIPELINE_HPP
@@ -0,0 +1,265 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef _GAMMA_UTILS_IMGSTORAGE_HPP
+#define _GAMMA_UTILS_IMGSTORAGE_HPP
+
+#include "ImgPixel.hpp"
+
+#include <sycl/sycl.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Storage policies for Img<Format, Storage>. Every policy provides
+//   resize(format, count)  make room for count pixels, keeping the old ones
+//   data(), size()         contiguous pixel array
+//   flush()                make the pixels durable where that means anything
+//   device_accessible      data() may be dereferenced inside a kernel
+// and its pixel array is what Img iterates, fills and writes.
+
+//////////////////////////
+// STORAGE: HOST VECTOR //
+//////////////////////////
+
+// default storage, pixels in a host vector; kernels go through a buffer
+class ImgVectorStorage {
+ private:
+  vector<ImgPixel> _pixels;
+
+ public:
+  static constexpr bool device_accessible = false;
+
+  template <typename Format>
+  void resize(Format const&, size_t count) {
+    _pixels.resize(count);
+  }
+
+  ImgPixel* data() noexcept { return _pixels.data(); }
+  ImgPixel const* data() const noexcept { return _pixels.data(); }
+  size_t size() const noexcept { return _pixels.size(); }
+
+  void flush() {}
+};
+
+//////////////////
+// STORAGE: USM //
+//////////////////
+
+// pixels in a USM allocation of the given queue, kernels use data() directly
+// so no buffer and no copy back are involved; with usm::alloc::device the
+// pixels live in device memory and must not be touched on the host
+// (iterators, fill(Functor), write)
+template <sycl::usm::alloc Kind = sycl::usm::alloc::shared>
+class ImgUsmStorage {
+ private:
+  sycl::queue _queue;
+  ImgPixel* _data = nullptr;
+  size_t _size = 0;
+
+ public:
+  static constexpr bool device_accessible = true;
+
+  explicit ImgUsmStorage(sycl::queue queue) : _queue(queue) {}
+
+  ImgUsmStorage(ImgUsmStorage const& other)
+      : _queue(other._queue), _size(other._size) {
+    if (!_size) return;
+    _data = sycl::malloc<ImgPixel>(_size, _queue, Kind);
+    _queue.memcpy(_data, other._data, _size * sizeof(ImgPixel)).wait();
+  }
+
+  ImgUsmStorage(ImgUsmStorage&& other) noexcept
+      : _queue(other._queue),
+        _data(exchange(other._data, nullptr)),
+        _size(exchange(other._size, 0)) {}
+
+  ImgUsmStorage& operator=(ImgUsmStorage other) noexcept {
+    swap(_queue, other._queue);
+    swap(_data, other._data);
+    swap(_size, other._size);
+    return *this;
+  }
+
+  ~ImgUsmStorage() {
+    if (_data) sycl::free(_data, _queue);
+  }
+
+  template <typename Format>
+  void resize(Format const&, size_t count) {
+    if (count == _size) return;
+
+    ImgPixel* data = nullptr;
+    if (count) {
+      data = sycl::malloc<ImgPixel>(count, _queue, Kind);
+      if (_size) _queue.memcpy(data, _data, min(count, _size) * sizeof(ImgPixel)).wait();
+    }
+    if (_data) sycl::free(_data, _queue);
+
+    _data = data;
+    _size = count;
+  }
+
+  ImgPixel* data() noexcept { return _data; }
+  ImgPixel const* data() const noexcept { return _data; }
+  size_t size() const noexcept { return _size; }
+
+  sycl::queue queue() const { return _queue; }
+
+  void flush() {}
+};
+
+#ifndef _WIN32
+//////////////////////////////
+// STORAGE: MAPPED BMP FILE //
+//////////////////////////////
+
+// pixels are the pixel region of a memory mapped BMP file, so the image is
+// processed in place and the file is complete without a separate write;
+// kernels reach the mapping through a buffer over the host pointer, which
+// CPU and integrated GPU devices can use without a copy
+class ImgMappedBMP {
+ private:
+  string _filename;
+  char* _map = nullptr;
+  size_t _mapSize = 0;
+  size_t _offset = 0;
+  size_t _count = 0;
+  int32_t _width = 0;
+  int32_t _height = 0;
+
+  void unmap() {
+    if (_map) munmap(_map, _mapSize);
+    _map = nullptr;
+    _mapSize = 0;
+  }
+
+  bool map(int fd, size_t size) {
+    void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+      cerr << "ImgMappedBMP: cannot map " << _filename << "\n";
+      return false;
+    }
+    _map = static_cast<char*>(map);
+    _mapSize = size;
+    return true;
+  }
+
+ public:
+  static constexpr bool device_accessible = false;
+
+  explicit ImgMappedBMP(string filename) : _filename(move(filename)) {}
+
+  ImgMappedBMP(ImgMappedBMP const&) = delete;
+  ImgMappedBMP& operator=(ImgMappedBMP const&) = delete;
+
+  ImgMappedBMP(ImgMappedBMP&& other) noexcept
+      : _filename(move(other._filename)),
+        _map(exchange(other._map, nullptr)),
+        _mapSize(exchange(other._mapSize, 0)),
+        _offset(other._offset),
+        _count(other._count),
+        _width(other._width),
+        _height(other._height) {}
+
+  ~ImgMappedBMP() { unmap(); }
+
+  // map an existing uncompressed 32 bit BMP, e.g. one written by Img::write
+  bool open() {
+    unmap();
+    _width = _height = 0;
+
+    int fd = ::open(_filename.c_str(), O_RDWR);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size < 54) {
+      cerr << "ImgMappedBMP::open: cannot open " << _filename << "\n";
+      if (fd >= 0) close(fd);
+      return false;
+    }
+    if (!map(fd, st.st_size)) return false;
+
+    uint16_t type, bitCount;
+    uint32_t offBits, compression;
+    memcpy(&type, _map, 2);
+    memcpy(&offBits, _map + 10, 4);
+    memcpy(&_width, _map + 18, 4);
+    memcpy(&_height, _map + 22, 4);
+    memcpy(&bitCount, _map + 28, 2);
+    memcpy(&compression, _map + 30, 4);
+
+    // the dimensions are checked before any arithmetic on them: a negative
+    // width wraps the pixel count and -INT32_MIN overflows
+    bool dims = _width > 0 && _height != 0 && _height != INT32_MIN;
+    if (dims && _height < 0) _height = -_height;
+
+    // width * height pixels must fit after the header, divided instead of
+    // multiplied so a huge header cannot wrap around
+    if (type != 0x4d42 || bitCount != 32 || compression != 0 || !dims ||
+        offBits > _mapSize ||
+        (_mapSize - offBits) / sizeof(ImgPixel) / size_t(_width) < size_t(_height)) {
+      cerr << "ImgMappedBMP::open: " << _filename
+           << " is not an uncompressed 32 bit BMP\n";
+      unmap();
+      _width = _height = 0;
+      return false;
+    }
+    _offset = offBits;
+    _count = size_t(_width) * _height;
+    return true;
+  }
+
+  // (re)create the file for count pixels, the header comes from the format
+  template <typename Format>
+  void resize(Format const& format, size_t count) {
+    unmap();
+
+    auto size = format.headerSize() + count * sizeof(ImgPixel);
+    int fd = ::open(_filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0 || ftruncate(fd, size) != 0) {
+      cerr << "ImgMappedBMP::resize: cannot create " << _filename << "\n";
+      if (fd >= 0) close(fd);
+      return;
+    }
+    if (!map(fd, size)) return;
+
+    format.writeHeader(_map);
+    _offset = format.headerSize();
+    _count = count;
+  }
+
+  ImgPixel* data() noexcept {
+    return _map ? reinterpret_cast<ImgPixel*>(_map + _offset) : nullptr;
+  }
+  ImgPixel const* data() const noexcept {
+    return _map ? reinterpret_cast<ImgPixel const*>(_map + _offset) : nullptr;
+  }
+  size_t size() const noexcept { return _map ? _count : 0; }
+
+  int32_t width() const noexcept { return _width; }
+  int32_t height() const noexcept { return _height; }
+
+  void flush() {
+    if (_map) msync(_map, _mapSize, MS_SYNC);
+  }
+};
+#endif  // _WIN32
+
+#endif  // _GAMMA_UTILS_IMGSTORAGE_HPP
@@ -0,0 +1,144 @@
+//==============================================================
+// Copyright © 2019 Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef _GAMMA_UTILS_IMGSTREAM_HPP
+#define _GAMMA_UTILS_IMGSTREAM_HPP
+
+#include "ImgPixel.hpp"
+
+#include <sycl/sycl.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Strip streaming of 32 bit BMP files that do not fit in host or device
+// memory at once. The image is read in strips of rows; every strip goes
+// through a slot (pinned host staging plus device memory), and with several
+// slots the upload, kernel and download of one strip overlap with reading
+// the next strip and writing the previous one. Memory use is
+// slots * stripRows * width pixels on either side, whatever the image size.
+
+struct ImgStreamStats {
+  int32_t width = 0;
+  int32_t height = 0;
+  int64_t strips = 0;
+  size_t stagingBytes = 0;  // host staging, the same again on the device
+};
+
+// one stage of the strip pipeline
+struct ImgStreamSlot {
+  ImgPixel* host = nullptr;    // pinned host staging memory
+  ImgPixel* device = nullptr;  // device memory
+  size_t count = 0;            // pixels of the strip in flight
+  sycl::event done;            // download of the strip in flight
+};
+
+// applies the point operation f to every pixel of input and writes output;
+// returns false (and reports on cerr) if input is not an uncompressed 32 bit BMP
+template <typename Functor>
+bool stream_pixels(sycl::queue q, string const& input, string const& output,
+                   Functor f, int32_t stripRows = 256, int slots = 3,
+                   ImgStreamStats* stats = nullptr) {
+  ifstream in(input, ios::binary);
+  char fileHeader[14];
+  char infoHeader[40];
+  if (!in.read(fileHeader, 14) || !in.read(infoHeader, 40)) {
+    cerr << "stream_pixels: cannot read " << input << "\n";
+    return false;
+  }
+
+  uint16_t type, bitCount;
+  uint32_t offBits, compression;
+  int32_t width, height;
+  memcpy(&type, fileHeader, 2);
+  memcpy(&offBits, fileHeader + 10, 4);
+  memcpy(&width, infoHeader + 4, 4);
+  memcpy(&height, infoHeader + 8, 4);
+  memcpy(&bitCount, infoHeader + 14, 2);
+  memcpy(&compression, infoHeader + 16, 4);
+  if (height < 0) height = -height;
+
+  if (type != 0x4d42 || bitCount != 32 || compression != 0 || offBits < 54) {
+    cerr << "stream_pixels: " << input << " is not an uncompressed 32 bit BMP\n";
+    return false;
+  }
+
+  // headers (and anything else in front of the pixels) are copied unchanged
+  vector<char> header(offBits);
+  in.seekg(0);
+  in.read(header.data(), offBits);
+  ofstream out(output, ios::binary);
+  out.write(header.data(), offBits);
+
+  stripRows = max(1, min(stripRows, height));
+  slots = max(1, slots);
+  size_t stripPixels = size_t(stripRows) * width;
+
+  vector<ImgStreamSlot> pipeline(slots);
+  for (auto& s : pipeline) {
+    s.host = sycl::malloc_host<ImgPixel>(stripPixels, q);
+    s.device = sycl::malloc_device<ImgPixel>(stripPixels, q);
+  }
+
+  // the slot was last used slots strips ago, its result is written before
+  // it is refilled, which keeps the output in strip order
+  auto drain = [&](ImgStreamSlot& s) {
+    s.done.wait();
+    out.write(reinterpret_cast<char const*>(s.host), s.count * sizeof(ImgPixel));
+    s.count = 0;
+  };
+
+  int64_t strips = 0;
+  for (int32_t row = 0; row < height; row += stripRows, ++strips) {
+    auto& s = pipeline[strips % slots];
+    if (s.count) drain(s);
+
+    size_t count = size_t(min(stripRows, height - row)) * width;
+    in.read(reinterpret_cast<char*>(s.host), count * sizeof(ImgPixel));
+    s.count = count;
+
+    // upload, kernel, download; every step depends only on the previous event
+    ImgPixel* pixels = s.device;
+    auto upload = q.memcpy(pixels, s.host, count * sizeof(ImgPixel));
+    auto kernel = q.submit([&](sycl::handler& h) {
+      h.depends_on(upload);
+      h.parallel_for(sycl::range<1>(count), [=](sycl::id<1> i) { f(pixels[i[0]]); });
+    });
+    s.done = q.memcpy(s.host, pixels, count * sizeof(ImgPixel), kernel);
+  }
+
+  for (int64_t i = 0; i < slots; ++i) {
+    auto& s = pipeline[(strips + i) % slots];
+    if (s.count) drain(s);
+  }
+
+  for (auto& s : pipeline) {
+    sycl::free(s.host, q);
+    sycl::free(s.device, q);
+  }
+
+  if (stats) {
+    stats->width = width;
+    stats->height = height;
+    stats->strips = strips;
+    stats->stagingBytes = slots * stripPixels * sizeof(ImgPixel);
+  }
+
+  if (!in || !out) {
+    cerr << "stream_pixels: I/O error on " << input << " or " << output << "\n";
+    return false;
+  }
+  return true;
+}
+
+#endif  // _GAMMA_UTILS_IMGSTREAM_HPP
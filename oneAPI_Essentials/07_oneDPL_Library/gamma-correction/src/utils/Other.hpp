@@ -18,6 +18,21 @@ inline double get_time_in_sec() {
          1.e-3;
 }
 
+// best of runs calls of f in seconds, measured with the full steady_clock
+// resolution so that sub-millisecond device passes are not rounded to zero
+template <typename Functor>
+double best_time_in_sec(Functor f, int runs = 5) {
+  using clock = std::chrono::steady_clock;
+  double best = 0;
+  for (int r = 0; r < runs; ++r) {
+    auto start = clock::now();
+    f();
+    double t = std::chrono::duration<double>(clock::now() - start).count();
+    if (r == 0 || t < best) best = t;
+  }
+  return best;
+}
+
 // function to check correctness
 template <typename It>
 bool check(It begin1, It end1, It begin2) {
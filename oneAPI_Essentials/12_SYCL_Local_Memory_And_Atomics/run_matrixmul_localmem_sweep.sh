@@ -0,0 +1,5 @@
+#!/bin/bash
+source /opt/intel/oneapi/setvars.sh > /dev/null 2>&1
+/bin/echo "##" $(whoami) is compiling SYCL_Essentials Module12 -- SYCL Local Memory tile shape sweep - matrixmul_localmem_sweep.cpp
+icpx -fsycl -O3 lab/matrixmul_localmem_sweep.cpp 
+if [ $? -eq 0 ]; then ./a.out 1024; fi
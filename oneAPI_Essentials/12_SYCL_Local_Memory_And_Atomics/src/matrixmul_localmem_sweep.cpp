@@ -0,0 +1,161 @@
+//==============================================================
+// Copyright © Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+
+#include <sycl/sycl.hpp>
+#include <iomanip>
+#include <string>
+
+using namespace sycl;
+
+//# Tiled matrix multiplication with compile-time tile shapes
+//# each work-group computes a TM x TN block of C, stepping through K in chunks of TK
+//# PAD extra floats per local memory row shift consecutive rows to different banks
+template <int TM, int TN, int TK, int PAD>
+event matmul_tiled(queue &q, const float *A, const float *B, float *C, size_t N) {
+    return q.submit([&](handler &h){
+        //# Define size for ND-range and work-group size
+        range<2> global_size(N,N);
+        range<2> work_group_size(TM,TN);
+
+        //# Create local accessors, rows padded by PAD elements
+        local_accessor<float, 2> A_local(range<2>(TM, TK + PAD), h);
+        local_accessor<float, 2> B_local(range<2>(TK, TN + PAD), h);
+
+        h.parallel_for(nd_range<2>{global_size, work_group_size}, [=](nd_item<2> item){
+            const int i = item.get_global_id(0);
+            const int j = item.get_global_id(1);
+            const int x = item.get_local_id(0);
+            const int y = item.get_local_id(1);
+            const int lid = x * TN + y;
+            const int i0 = item.get_group(0) * TM;
+            const int j0 = item.get_group(1) * TN;
+
+            float temp = 0.f;
+            for (int t = 0; t < N; t += TK) {
+                //# all work-items of the group cooperatively copy both tiles
+                for (int e = lid; e < TM * TK; e += TM * TN)
+                    A_local[e / TK][e % TK] = A[(i0 + e / TK) * N + t + e % TK];
+                for (int e = lid; e < TK * TN; e += TM * TN)
+                    B_local[e / TN][e % TN] = B[(t + e / TN) * N + j0 + e % TN];
+
+                //# barrier to sychronize local memory copy across all work items
+                group_barrier(item.get_group());
+
+                for (int k = 0; k < TK; k++) {
+                    temp += A_local[x][k] * B_local[k][y];
+                }
+                group_barrier(item.get_group());
+            }
+            C[i*N+j] = temp;
+        });
+    });
+}
+
+struct sweep_result {
+    std::string config;
+    double seconds;
+};
+
+//# run one configuration if it fits the device, record the best of 3 runs
+template <int TM, int TN, int TK, int PAD>
+void run_config(queue &q, const float *A, const float *B, float *C, const std::vector<float> &ref, size_t N, std::vector<sweep_result> &results) {
+    auto dev = q.get_device();
+    size_t local_mem_size = dev.get_info<info::device::local_mem_size>();
+    size_t max_wg_size = dev.get_info<info::device::max_work_group_size>();
+    size_t local_bytes = sizeof(float) * (TM * (TK + PAD) + TK * (TN + PAD));
+
+    std::string config = std::to_string(TM) + "x" + std::to_string(TN) + "x" + std::to_string(TK) + (PAD ? " pad" : "    ");
+
+    //# prune configurations the device cannot run
+    if (local_bytes > local_mem_size || TM * TN > max_wg_size || N % TM || N % TN || N % TK) {
+        std::cout << std::setw(16) << config << " : skipped\n";
+        return;
+    }
+
+    double best = 0;
+    for (int r = 0; r < 3; r++) {
+        q.memset(C, 0, sizeof(float) * N * N).wait();
+        event e = matmul_tiled<TM, TN, TK, PAD>(q, A, B, C, N);
+        e.wait();
+        double t = (e.get_profiling_info<info::event_profiling::command_end>() - e.get_profiling_info<info::event_profiling::command_start>()) / 1e+9;
+        if (r == 0 || t < best) best = t;
+    }
+
+    std::vector<float> result(N*N);
+    q.memcpy(result.data(), C, sizeof(float) * N * N).wait();
+    bool pass = (result == ref);
+
+    std::cout << std::setw(16) << config << " : " << std::setw(10) << best << " s  " << std::setw(8) << 2.0 * N * N * N / best / 1e+9 << " GFLOPS  " << (pass ? "PASS" : "FAIL") << "\n";
+    if (pass) results.push_back({config, best});
+}
+
+//# instantiate every TK and padding choice for one TM x TN work-group shape
+template <int TM, int TN, int... TKs>
+void sweep_k(queue &q, const float *A, const float *B, float *C, const std::vector<float> &ref, size_t N, std::vector<sweep_result> &results) {
+    (run_config<TM, TN, TKs, 0>(q, A, B, C, ref, N, results), ...);
+    (run_config<TM, TN, TKs, 1>(q, A, B, C, ref, N, results), ...);
+}
+
+int main(int argc, char *argv[]) {
+
+    size_t N = 512;
+    if (argc > 1) N = std::atoi(argv[1]);
+    std::cout << "MATRIX_SIZE    : " << N << "x" << N << std::endl;
+
+    //# Initialize matrices with small integers so every summation order gives the exact same result
+    std::vector<float> matrix_a(N*N);
+    std::vector<float> matrix_b(N*N);
+    std::vector<float> matrix_d(N*N);
+    for (int i=0; i<N; i++)
+        for (int j=0; j<N; j++){
+            matrix_a[i*N+j] = (i*N+j) % 7;
+            matrix_b[i*N+j] = (i+j) % 5;
+            matrix_d[i*N+j] = 0.f;
+    }
+    for (int i=0; i<N; i++)
+        for (int k=0; k<N; k++)
+            for (int j=0; j<N; j++)
+                matrix_d[i*N+j] += matrix_a[i*N+k] * matrix_b[k*N+j];
+
+    //# Sweep every available device
+    for (auto &dev : device::get_devices()) {
+        queue q(dev, property::queue::enable_profiling{});
+        std::cout << "\nOffload Device : " << dev.get_info<info::device::name>() << std::endl;
+        std::cout << "local_mem_size : " << dev.get_info<info::device::local_mem_size>() << std::endl;
+
+        float *A = malloc_device<float>(N*N, q);
+        float *B = malloc_device<float>(N*N, q);
+        float *C = malloc_device<float>(N*N, q);
+        q.memcpy(A, matrix_a.data(), sizeof(float) * N * N);
+        q.memcpy(B, matrix_b.data(), sizeof(float) * N * N);
+        q.wait();
+
+        //# TM x TN x TK tile grid, each with and without padding
+        std::vector<sweep_result> results;
+        sweep_k<8, 8, 8, 16, 32>(q, A, B, C, matrix_d, N, results);
+        sweep_k<8, 16, 8, 16, 32>(q, A, B, C, matrix_d, N, results);
+        sweep_k<16, 8, 8, 16, 32>(q, A, B, C, matrix_d, N, results);
+        sweep_k<16, 16, 8, 16, 32>(q, A, B, C, matrix_d, N, results);
+        sweep_k<16, 32, 8, 16, 32>(q, A, B, C, matrix_d, N, results);
+        sweep_k<32, 16, 8, 16, 32>(q, A, B, C, matrix_d, N, results);
+        sweep_k<32, 32, 8, 16, 32>(q, A, B, C, matrix_d, N, results);
+
+        free(A, q);
+        free(B, q);
+        free(C, q);
+
+        if (results.empty()) {
+            std::cout << "No valid configuration\n";
+            continue;
+        }
+        auto best = results[0];
+        for (auto &r : results) if (r.seconds < best.seconds) best = r;
+        std::cout << "Best (TMxTNxTK) : " << best.config << " " << best.seconds << " s\n";
+    }
+
+    return 0;
+}